@@ -0,0 +1,287 @@
+/*
+ * arena.c
+ *
+ * Arena allocator module
+ * Each game (and each batch) takes all of its memory from one arena, so
+ * restarting a game is a pointer reset instead of a round of free and
+ * malloc calls. Blocks are chained and never returned before
+ * Arena_Destroy, which keeps addresses stable across restarts and leaves
+ * nothing behind to fragment the heap.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * One block of arena memory; data follows the header
+ */
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t capacity;
+    unsigned char data[];
+};
+
+// ============================================================================
+// BLOCK MANAGEMENT
+// ============================================================================
+
+/*
+ * Offset of the first suitably aligned byte at or after used
+ *
+ * @param block - Block to allocate from
+ * @param used - Bytes already taken in the block
+ * @param alignment - Required alignment (power of two)
+ * @return Aligned offset into block->data
+ */
+static size_t Arena_AlignOffset(const ArenaBlock* block, size_t used, size_t alignment)
+{
+    uintptr_t address = (uintptr_t)block->data + used;
+    uintptr_t aligned = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    return used + (size_t)(aligned - address);
+}
+
+/*
+ * Move on to a block with room for size bytes at the given alignment
+ * The block after the current one is reused when it is large enough;
+ * otherwise a new block is linked in right after the current one.
+ *
+ * @param arena - Pointer to arena
+ * @param size - Bytes about to be allocated
+ * @param alignment - Required alignment (power of two)
+ * @return true on success, false if memory could not be allocated
+ */
+static bool Arena_AdvanceBlock(Arena* arena, size_t size, size_t alignment)
+{
+    ArenaBlock* next = (arena->current != NULL) ? arena->current->next : arena->first;
+
+    if ((next != NULL) && (size + alignment <= next->capacity))
+    {
+        arena->current = next;
+        arena->used = 0;
+        return true;
+    }
+
+    size_t blockSize = (arena->blockSize > 0) ? arena->blockSize : ARENA_BLOCK_SIZE;
+    size_t capacity = (size + alignment > blockSize) ? size + alignment : blockSize;
+    if (capacity > SIZE_MAX - sizeof(ArenaBlock))
+    {
+        return false;
+    }
+
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + capacity);
+    if (block == NULL)
+    {
+        return false;
+    }
+
+    block->capacity = capacity;
+    block->next = next;
+    if (arena->current != NULL)
+    {
+        arena->current->next = block;
+    }
+    else
+    {
+        arena->first = block;
+    }
+
+    arena->current = block;
+    arena->used = 0;
+    return true;
+}
+
+// ============================================================================
+// CREATION AND DESTRUCTION
+// ============================================================================
+
+/*
+ * Set up an empty arena; no memory is taken until the first allocation
+ *
+ * @param arena - Pointer to arena to initialize
+ * @param blockSize - Minimum size of each block, or 0 for ARENA_BLOCK_SIZE
+ */
+void Arena_Initialize(Arena* arena, size_t blockSize)
+{
+    assert(arena != NULL);
+
+    memset(arena, 0, sizeof(Arena));
+    arena->blockSize = blockSize;
+}
+
+/*
+ * Release every block owned by an arena and leave it empty
+ *
+ * @param arena - Pointer to arena to destroy
+ */
+void Arena_Destroy(Arena* arena)
+{
+    assert(arena != NULL);
+
+    ArenaBlock* block = arena->first;
+    while (block != NULL)
+    {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    Arena_Initialize(arena, arena->blockSize);
+}
+
+// ============================================================================
+// ALLOCATION
+// ============================================================================
+
+/*
+ * Take size bytes from the arena
+ * The memory is not cleared and stays valid until the arena is reset
+ * past it or destroyed
+ *
+ * @param arena - Pointer to arena
+ * @param size - Number of bytes
+ * @param alignment - Required alignment (power of two)
+ * @return Pointer to the memory, or NULL if it could not be allocated
+ */
+void* Arena_Allocate(Arena* arena, size_t size, size_t alignment)
+{
+    assert(arena != NULL);
+    assert((alignment > 0) && ((alignment & (alignment - 1)) == 0));
+
+    if (size > SIZE_MAX / 2)
+    {
+        return NULL;
+    }
+
+    if (arena->current != NULL)
+    {
+        size_t offset = Arena_AlignOffset(arena->current, arena->used, alignment);
+        if ((offset <= arena->current->capacity) && (size <= arena->current->capacity - offset))
+        {
+            arena->used = offset + size;
+            return arena->current->data + offset;
+        }
+    }
+
+    if (!Arena_AdvanceBlock(arena, size, alignment))
+    {
+        return NULL;
+    }
+
+    size_t offset = Arena_AlignOffset(arena->current, 0, alignment);
+    arena->used = offset + size;
+    return arena->current->data + offset;
+}
+
+/*
+ * Grow or shrink the most recent allocation
+ * The last allocation is resized in place when the block has room;
+ * anything else is copied into a new allocation and the old bytes are
+ * left to the next reset.
+ *
+ * @param arena - Pointer to arena
+ * @param memory - Allocation to resize, or NULL for a new one
+ * @param oldSize - Current size of memory in bytes
+ * @param newSize - Requested size in bytes
+ * @param alignment - Alignment memory was allocated with
+ * @return Pointer to the resized memory, or NULL if it could not be
+ *         allocated (memory is then left untouched)
+ */
+void* Arena_Resize(Arena* arena, void* memory, size_t oldSize, size_t newSize, size_t alignment)
+{
+    assert(arena != NULL);
+
+    if (memory == NULL)
+    {
+        return Arena_Allocate(arena, newSize, alignment);
+    }
+
+    ArenaBlock* block = arena->current;
+    unsigned char* bytes = memory;
+    bool isLast = (block != NULL) && (bytes >= block->data) &&
+                  (bytes + oldSize == block->data + arena->used);
+
+    if (isLast && (newSize <= block->capacity - (size_t)(bytes - block->data)))
+    {
+        arena->used = (size_t)(bytes - block->data) + newSize;
+        return memory;
+    }
+
+    void* resized = Arena_Allocate(arena, newSize, alignment);
+    if (resized != NULL)
+    {
+        memcpy(resized, memory, (oldSize < newSize) ? oldSize : newSize);
+    }
+
+    return resized;
+}
+
+// ============================================================================
+// RESET
+// ============================================================================
+
+/*
+ * Drop every allocation in O(1); the blocks are kept for reuse
+ *
+ * @param arena - Pointer to arena
+ */
+void Arena_Reset(Arena* arena)
+{
+    assert(arena != NULL);
+
+    arena->current = NULL;
+    arena->used = 0;
+}
+
+/*
+ * Get the current position, to drop later allocations with
+ * Arena_ResetToMark
+ *
+ * @param arena - Pointer to arena
+ * @return Current position
+ */
+ArenaMark Arena_GetMark(const Arena* arena)
+{
+    assert(arena != NULL);
+
+    ArenaMark mark = { arena->current, arena->used };
+    return mark;
+}
+
+/*
+ * Drop every allocation made after a mark in O(1)
+ *
+ * @param arena - Pointer to arena
+ * @param mark - Position from Arena_GetMark, taken since the last reset
+ */
+void Arena_ResetToMark(Arena* arena, ArenaMark mark)
+{
+    assert(arena != NULL);
+
+    arena->current = mark.block;
+    arena->used = mark.used;
+}
+
+/*
+ * Get the total size of the blocks an arena holds
+ *
+ * @param arena - Pointer to arena
+ * @return Bytes reserved from the heap
+ */
+size_t Arena_GetReservedSize(const Arena* arena)
+{
+    assert(arena != NULL);
+
+    size_t total = 0;
+    for (const ArenaBlock* block = arena->first; block != NULL; block = block->next)
+    {
+        total += block->capacity;
+    }
+
+    return total;
+}
@@ -0,0 +1,473 @@
+/*
+ * batch.c
+ *
+ * Batched simulation module
+ * Steps many independent games with one call. State is kept as
+ * structure-of-arrays so the per-game work in Batch_Step touches a few
+ * small arrays and one slab per game, and each game's observation plane
+ * is patched in place instead of being rebuilt every tick.
+ * Arrays are cache-line aligned, so splitting games into chunks of
+ * BATCH_CHUNK_GAMES keeps threads from writing to the same lines
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <string.h>
+
+#define CACHE_LINE_SIZE    64
+#define BATCH_CHUNK_GAMES  64  // 64 one-byte entries fill a cache line
+
+// Direction for each SimAction (SIM_ACTION_NONE keeps the heading)
+static const int8_t actionDirectionX[] = { 0, 0, 0, -1, 1 };
+static const int8_t actionDirectionY[] = { 0, -1, 1, 0, 0 };
+
+// ============================================================================
+// CREATION AND DESTRUCTION
+// ============================================================================
+
+/*
+ * Take zeroed, cache-line aligned storage from the batch arena
+ *
+ * @param batch - Pointer to batch
+ * @param size - Number of bytes
+ * @return Pointer to storage, or NULL on failure
+ */
+static void* Batch_Allocate(SnakeBatch* batch, size_t size)
+{
+    void* memory = Arena_Allocate(&batch->arena, size, CACHE_LINE_SIZE);
+
+    if (memory != NULL)
+    {
+        memset(memory, 0, size);
+    }
+
+    return memory;
+}
+
+/*
+ * Bytes one array takes in the arena, including alignment padding
+ */
+static size_t Batch_ArraySize(size_t size)
+{
+    return size + CACHE_LINE_SIZE;
+}
+
+/*
+ * Allocate storage for a batch of games and reset all of them
+ * Every array comes from the batch arena, sized up front to one block
+ *
+ * @param batch - Pointer to batch to create
+ * @param gameCount - Number of independent games
+ * @param columns - Grid columns of every game
+ * @param rows - Grid rows of every game
+ * @param seed - Base seed; game i uses random stream i of this seed
+ * @return true on success, false if the board is smaller than 2x2 or has
+ *         BATCH_NO_FOOD cells or more (cells are 16-bit), or if memory
+ *         could not be allocated
+ */
+bool Batch_Create(SnakeBatch* batch, int gameCount, int columns, int rows, uint64_t seed)
+{
+    assert(batch != NULL);
+    assert(gameCount > 0);
+
+    memset(batch, 0, sizeof(*batch));
+
+    if ((columns < 2) || (rows < 2) || ((long)columns * rows >= BATCH_NO_FOOD))
+    {
+        return false;
+    }
+
+    batch->gameCount = gameCount;
+    batch->columns = columns;
+    batch->rows = rows;
+    batch->cellCount = columns * rows;
+    batch->occupancyWords = (batch->cellCount + 63) / 64;
+
+    size_t games = (size_t)gameCount;
+    size_t cells = games * (size_t)batch->cellCount;
+    size_t occupancyBytes = games * (size_t)batch->occupancyWords * sizeof(uint64_t);
+
+    // headX, headY, ringHead, length and foodCell, then the rest in order
+    size_t arenaSize = 5 * Batch_ArraySize(games * sizeof(uint16_t)) +
+                       2 * Batch_ArraySize(games * sizeof(int8_t)) +
+                       Batch_ArraySize(games * sizeof(int32_t)) +
+                       Batch_ArraySize(games * sizeof(uint8_t)) +
+                       Batch_ArraySize(games * sizeof(Rng)) +
+                       2 * Batch_ArraySize(cells * sizeof(uint16_t)) +  // body, cellSlot
+                       Batch_ArraySize(occupancyBytes) +
+                       Batch_ArraySize(cells * sizeof(uint8_t));
+    Arena_Initialize(&batch->arena, arenaSize);
+
+    batch->headX = Batch_Allocate(batch, games * sizeof(uint16_t));
+    batch->headY = Batch_Allocate(batch, games * sizeof(uint16_t));
+    batch->directionX = Batch_Allocate(batch, games * sizeof(int8_t));
+    batch->directionY = Batch_Allocate(batch, games * sizeof(int8_t));
+    batch->ringHead = Batch_Allocate(batch, games * sizeof(uint16_t));
+    batch->length = Batch_Allocate(batch, games * sizeof(uint16_t));
+    batch->foodCell = Batch_Allocate(batch, games * sizeof(uint16_t));
+    batch->score = Batch_Allocate(batch, games * sizeof(int32_t));
+    batch->events = Batch_Allocate(batch, games * sizeof(uint8_t));
+    batch->rng = Batch_Allocate(batch, games * sizeof(Rng));
+
+    batch->body = Batch_Allocate(batch, cells * sizeof(uint16_t));
+    batch->cellSlot = Batch_Allocate(batch, cells * sizeof(uint16_t));
+    batch->occupancy = Batch_Allocate(batch, occupancyBytes);
+    batch->observations = Batch_Allocate(batch, cells * sizeof(uint8_t));
+
+    if (!batch->headX || !batch->headY || !batch->directionX || !batch->directionY ||
+        !batch->ringHead || !batch->length || !batch->foodCell || !batch->score ||
+        !batch->events || !batch->rng || !batch->body || !batch->cellSlot ||
+        !batch->occupancy || !batch->observations)
+    {
+        Batch_Destroy(batch);
+        return false;
+    }
+
+    // Zero length and no food: the first reset has nothing to undo
+    for (int game = 0; game < gameCount; game++)
+    {
+        batch->foodCell[game] = BATCH_NO_FOOD;
+        Rng_Seed(&batch->rng[game], seed, (uint64_t)game);
+    }
+
+    Batch_Reset(batch);
+    return true;
+}
+
+/*
+ * Release all storage owned by a batch
+ *
+ * @param batch - Pointer to batch to destroy
+ */
+void Batch_Destroy(SnakeBatch* batch)
+{
+    assert(batch != NULL);
+
+    Arena_Destroy(&batch->arena);
+    memset(batch, 0, sizeof(*batch));
+}
+
+// ============================================================================
+// FOOD PLACEMENT
+// ============================================================================
+
+/*
+ * Place food for one game on a uniformly random free cell
+ * One random draw picks the rank of the free cell; the rank is resolved
+ * with a popcount walk over the occupancy words, so the cost is one draw
+ * plus cellCount / 64 word operations regardless of fill level
+ *
+ * @param batch - Pointer to batch
+ * @param game - Index of the game
+ * @param headCell - Current head cell (not part of the body bitset)
+ */
+static void Batch_SpawnFood(SnakeBatch* batch, int game, int headCell)
+{
+    const uint64_t* occupancy = batch->occupancy + (size_t)game * batch->occupancyWords;
+    int freeCount = batch->cellCount - batch->length[game];
+
+    if (freeCount <= 0)
+    {
+        batch->foodCell[game] = BATCH_NO_FOOD;
+        return;
+    }
+
+    int rank = (int)Rng_NextBounded(&batch->rng[game], (uint32_t)freeCount);
+
+    for (int word = 0; word < batch->occupancyWords; word++)
+    {
+        uint64_t freeBits = ~occupancy[word];
+
+        if (word == (headCell >> 6))
+        {
+            freeBits &= ~((uint64_t)1 << (headCell & 63));
+        }
+        if (word == batch->occupancyWords - 1 && (batch->cellCount & 63) != 0)
+        {
+            freeBits &= ((uint64_t)1 << (batch->cellCount & 63)) - 1;
+        }
+
+        int available = __builtin_popcountll(freeBits);
+        if (rank >= available)
+        {
+            rank -= available;
+            continue;
+        }
+
+        // Drop the lowest free bits until the chosen one is lowest
+        while (rank-- > 0)
+        {
+            freeBits &= freeBits - 1;
+        }
+
+        int cell = (word << 6) + __builtin_ctzll(freeBits);
+        batch->foodCell[game] = (uint16_t)cell;
+        batch->observations[(size_t)game * batch->cellCount + cell] = OBS_FOOD;
+        return;
+    }
+
+    batch->foodCell[game] = BATCH_NO_FOOD;
+}
+
+// ============================================================================
+// RESET
+// ============================================================================
+
+/*
+ * Reset one game to the start position
+ * Only the observation cells the previous episode covered are cleared,
+ * so the cost does not depend on the board size
+ *
+ * @param batch - Pointer to batch
+ * @param game - Index of the game to reset
+ */
+void Batch_ResetGame(SnakeBatch* batch, int game)
+{
+    assert(batch != NULL);
+    assert(game >= 0 && game < batch->gameCount);
+
+    int cellCount = batch->cellCount;
+    size_t base = (size_t)game * cellCount;
+    uint16_t* body = batch->body + base;
+    uint8_t* observation = batch->observations + base;
+
+    // Undo the previous episode
+    for (int i = 0; i < batch->length[game]; i++)
+    {
+        int slot = batch->ringHead[game] - i;
+        if (slot < 0) slot += cellCount;
+
+        observation[body[slot]] = OBS_EMPTY;
+    }
+
+    if (batch->foodCell[game] != BATCH_NO_FOOD)
+    {
+        observation[batch->foodCell[game]] = OBS_EMPTY;
+    }
+
+    memset(batch->occupancy + (size_t)game * batch->occupancyWords, 0,
+           (size_t)batch->occupancyWords * sizeof(uint64_t));
+
+    // Snake starts in the top-left cell heading right
+    batch->headX[game] = 0;
+    batch->headY[game] = 0;
+    batch->directionX[game] = 1;
+    batch->directionY[game] = 0;
+    batch->ringHead[game] = 0;
+    batch->length[game] = 1;
+    batch->score[game] = 0;
+    body[0] = 0;
+    batch->cellSlot[base] = 0;
+    observation[0] = OBS_HEAD;
+
+    Batch_SpawnFood(batch, game, 0);
+}
+
+/*
+ * Reset every game in the batch
+ *
+ * @param batch - Pointer to batch
+ */
+void Batch_Reset(SnakeBatch* batch)
+{
+    assert(batch != NULL);
+
+    for (int game = 0; game < batch->gameCount; game++)
+    {
+        Batch_ResetGame(batch, game);
+        batch->events[game] = SIM_EVENT_NONE;
+    }
+}
+
+// ============================================================================
+// BATCH STEP
+// ============================================================================
+
+/*
+ * Advance games [begin, end) by one move tick
+ * Same rules as Sim_Step. Afterwards events[game] holds the SimEvent
+ * flags for that game; games that died have already been reset.
+ *
+ * @param batch - Pointer to batch
+ * @param actions - One SimAction per game in the whole batch
+ * @param begin - First game to step
+ * @param end - One past the last game to step
+ */
+static void Batch_StepRange(SnakeBatch* batch, const uint8_t* actions, int begin, int end)
+{
+
+    // Hoist every array into a local: stores into the byte-sized
+    // observation plane may alias anything reached through batch
+    const int columns = batch->columns;
+    const int rows = batch->rows;
+    const int cellCount = batch->cellCount;
+    const int words = batch->occupancyWords;
+
+    uint16_t* headX = batch->headX;
+    uint16_t* headY = batch->headY;
+    int8_t* directionXs = batch->directionX;
+    int8_t* directionYs = batch->directionY;
+    uint16_t* ringHeads = batch->ringHead;
+    uint16_t* lengths = batch->length;
+    uint16_t* foodCells = batch->foodCell;
+    int32_t* scores = batch->score;
+    uint8_t* events = batch->events;
+    uint16_t* bodies = batch->body;
+    uint16_t* cellSlots = batch->cellSlot;
+    uint64_t* occupancies = batch->occupancy;
+    uint8_t* observations = batch->observations;
+
+    for (int game = begin; game < end; game++)
+    {
+        size_t base = (size_t)game * cellCount;
+        uint16_t* body = bodies + base;
+        uint64_t* occupancy = occupancies + (size_t)game * words;
+        uint8_t* observation = observations + base;
+
+        // Turn only across the current axis (table lookup, no branches);
+        // values outside SimAction keep the heading
+        int directionX = directionXs[game];
+        int directionY = directionYs[game];
+        int action = actions[game];
+        action = (action <= SIM_ACTION_RIGHT) ? action : SIM_ACTION_NONE;
+        int turnX = actionDirectionX[action];
+        int turnY = actionDirectionY[action];
+        int turn = ((turnX != 0) & (directionX == 0)) | ((turnY != 0) & (directionY == 0));
+
+        directionX = turn ? turnX : directionX;
+        directionY = turn ? turnY : directionY;
+        directionXs[game] = (int8_t)directionX;
+        directionYs[game] = (int8_t)directionY;
+
+        // Step the head with wrap-around on both axes
+        int x = headX[game] + directionX;
+        int y = headY[game] + directionY;
+
+        x = (x >= columns) ? 0 : ((x < 0) ? columns - 1 : x);
+        y = (y >= rows) ? 0 : ((y < 0) ? rows - 1 : y);
+
+        int length = lengths[game];
+        int ringHead = ringHeads[game];
+        int tailSlot = ringHead - (length - 1);
+        if (tailSlot < 0) tailSlot += cellCount;
+
+        int oldHead = body[ringHead];
+        int tailCell = body[tailSlot];
+        int newHead = y * columns + x;
+
+        // Body occupancy excludes the head, as in the single-game snake
+        observation[tailCell] = OBS_EMPTY;
+        if (length > 1)
+        {
+            occupancy[tailCell >> 6] &= ~((uint64_t)1 << (tailCell & 63));
+            occupancy[oldHead >> 6] |= (uint64_t)1 << (oldHead & 63);
+            observation[oldHead] = OBS_BODY;
+        }
+
+        ringHead = (ringHead + 1 == cellCount) ? 0 : ringHead + 1;
+        body[ringHead] = (uint16_t)newHead;
+        cellSlots[base + newHead] = (uint16_t)ringHead;
+        ringHeads[game] = (uint16_t)ringHead;
+        headX[game] = (uint16_t)x;
+        headY[game] = (uint16_t)y;
+
+        if ((occupancy[newHead >> 6] >> (newHead & 63)) & 1)
+        {
+            events[game] = SIM_EVENT_DIED;
+            Batch_ResetGame(batch, game);
+            continue;
+        }
+
+        observation[newHead] = OBS_HEAD;
+
+        if (newHead == foodCells[game])
+        {
+            // Take back the tail advance
+            occupancy[tailCell >> 6] |= (uint64_t)1 << (tailCell & 63);
+            observation[tailCell] = OBS_BODY;
+
+            lengths[game] = (uint16_t)(length + 1);
+            scores[game]++;
+            events[game] = SIM_EVENT_ATE;
+
+            Batch_SpawnFood(batch, game, newHead);
+        }
+        else
+        {
+            events[game] = SIM_EVENT_NONE;
+        }
+    }
+}
+
+/*
+ * Arguments for a parallel batch step
+ */
+typedef struct {
+    SnakeBatch* batch;
+    const uint8_t* actions;
+} BatchStepJob;
+
+/*
+ * Thread pool task: step one chunk of games
+ */
+static void Batch_StepTask(void* context, int begin, int end)
+{
+    BatchStepJob* job = context;
+    Batch_StepRange(job->batch, job->actions, begin, end);
+}
+
+/*
+ * Advance every game by one move tick on the calling thread
+ *
+ * @param batch - Pointer to batch
+ * @param actions - One SimAction per game; other values count as SIM_ACTION_NONE
+ */
+void Batch_Step(SnakeBatch* batch, const uint8_t* actions)
+{
+    assert(batch != NULL);
+    assert(actions != NULL);
+
+    Batch_StepRange(batch, actions, 0, batch->gameCount);
+}
+
+/*
+ * Advance every game by one move tick across a thread pool
+ * Games are independent and each owns its random stream, so the result
+ * is identical to Batch_Step for any number of threads
+ *
+ * @param batch - Pointer to batch
+ * @param actions - One SimAction per game; other values count as SIM_ACTION_NONE
+ * @param pool - Thread pool to run on
+ */
+void Batch_StepParallel(SnakeBatch* batch, const uint8_t* actions, ThreadPool* pool)
+{
+    assert(batch != NULL);
+    assert(actions != NULL);
+    assert(pool != NULL);
+
+    BatchStepJob job = { batch, actions };
+    ThreadPool_ParallelFor(pool, batch->gameCount, BATCH_CHUNK_GAMES, Batch_StepTask, &job);
+}
+
+// ============================================================================
+// OBSERVATIONS
+// ============================================================================
+
+/*
+ * Get the observation plane of one game
+ * rows * columns bytes in row-major order holding ObservationCell codes
+ *
+ * @param batch - Pointer to batch
+ * @param game - Index of the game
+ * @return Pointer into the batch's observation buffer
+ */
+const uint8_t* Batch_GetObservation(const SnakeBatch* batch, int game)
+{
+    assert(batch != NULL);
+    assert(game >= 0 && game < batch->gameCount);
+
+    return batch->observations + (size_t)game * batch->cellCount;
+}
@@ -0,0 +1,91 @@
+/*
+ * bench_batch.c
+ *
+ * Batched environment throughput benchmark
+ * Steps many 16x16 games with Batch_Step and reports env-steps per second
+ * on a single core for several batch sizes, then the deaths per env-step
+ * over a short untimed run to show that dead games are reset and go on
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BOARD_SIZE     16
+#define ACTION_FRAMES  64
+#define TOTAL_STEPS    200000000.0
+#define DEATH_STEPS    256      // Untimed steps that count deaths in every game
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Time Batch_Step for one batch size
+ * Actions are pre-generated (mostly straight moves with random turns) so
+ * the measurement covers only the simulation
+ *
+ * @param gameCount - Number of games in the batch
+ */
+static void Bench_RunBatch(int gameCount)
+{
+    SnakeBatch batch;
+    uint8_t* actions = malloc((size_t)gameCount * ACTION_FRAMES);
+
+    if (actions == NULL || !Batch_Create(&batch, gameCount, BOARD_SIZE, BOARD_SIZE, 1))
+    {
+        fprintf(stderr, "out of memory for %d games\n", gameCount);
+        free(actions);
+        return;
+    }
+
+    for (int i = 0; i < gameCount * ACTION_FRAMES; i++)
+    {
+        actions[i] = (rand() % 4 == 0) ? (uint8_t)(rand() % 5) : SIM_ACTION_NONE;
+    }
+
+    int steps = (int)(TOTAL_STEPS / gameCount);
+
+    double start = Bench_NowNs();
+    for (int step = 0; step < steps; step++)
+    {
+        Batch_Step(&batch, actions + (size_t)(step % ACTION_FRAMES) * gameCount);
+    }
+    double seconds = (Bench_NowNs() - start) / 1e9;
+
+    long long deaths = 0;
+    for (int step = 0; step < DEATH_STEPS; step++)
+    {
+        Batch_Step(&batch, actions + (size_t)(step % ACTION_FRAMES) * gameCount);
+        for (int game = 0; game < gameCount; game++)
+        {
+            deaths += (batch.events[game] & SIM_EVENT_DIED) != 0;
+        }
+    }
+
+    double envSteps = (double)steps * gameCount;
+    printf("games %6d: %8.2f M env-steps/s (%.2f ns/step), %.5f deaths per env-step\n",
+           gameCount, envSteps / seconds / 1e6, seconds * 1e9 / envSteps,
+           (double)deaths / ((double)DEATH_STEPS * gameCount));
+
+    Batch_Destroy(&batch);
+    free(actions);
+}
+
+/*
+ * Program main entry point
+ */
+int main(void)
+{
+    const int gameCounts[] = { 64, 1024, 16384 };
+
+    for (size_t i = 0; i < sizeof(gameCounts) / sizeof(gameCounts[0]); i++)
+    {
+        Bench_RunBatch(gameCounts[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * bench_collision.c
+ *
+ * Self-collision microbenchmark
+ * Compares the legacy linear segment scan against the occupancy bitset
+ * test for snakes of length 10, 400 and 100000
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// ============================================================================
+// COLLISION PATHS
+// ============================================================================
+
+/*
+ * Legacy path: compare the head against every body segment
+ */
+static bool Bench_LinearCollision(const Position* segments, int length)
+{
+    for (int i = 1; i < length; i++)
+    {
+        if ((segments[0].x == segments[i].x) && (segments[0].y == segments[i].y))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Bitset path: convert the head to a cell and test one bit
+ */
+static bool Bench_BitsetCollision(const uint64_t* bits, Position head, int columns)
+{
+    int cell = (int)(head.y / SQUARE_SIZE) * columns + (int)(head.x / SQUARE_SIZE);
+    return Occupancy_IsOccupied(bits, cell);
+}
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Lay a snake of the given length out in a serpentine pattern on a square
+ * board just large enough to hold it, with the head on a free cell, then
+ * time both collision paths on the no-collision (worst) case
+ *
+ * @param length - Number of segments in the synthetic snake
+ */
+static void Bench_RunLength(int length)
+{
+    int columns = (int)ceil(sqrt((double)length + 1.0));
+    int cells = columns * columns;
+
+    Position* segments = malloc((size_t)length * sizeof(Position));
+    uint64_t* bits = malloc((size_t)((cells + 63) / 64) * sizeof(uint64_t));
+    if (segments == NULL || bits == NULL)
+    {
+        fprintf(stderr, "out of memory for length %d\n", length);
+        free(segments);
+        free(bits);
+        return;
+    }
+
+    Occupancy_ClearAll(bits, cells);
+
+    // Body occupies cells 1..length-1 of the serpentine, head sits on cell length
+    for (int i = 0; i < length; i++)
+    {
+        int index = (i == 0) ? length : i;
+        int row = index / columns;
+        int column = (row % 2 == 0) ? (index % columns) : (columns - 1 - index % columns);
+
+        segments[i] = (Position){ (float)(column * SQUARE_SIZE), (float)(row * SQUARE_SIZE) };
+        if (i > 0)
+        {
+            Occupancy_Mark(bits, row * columns + column);
+        }
+    }
+
+    int iterations = 200000000 / length;
+    if (iterations < 1000)
+    {
+        iterations = 1000;
+    }
+
+    volatile int sink = 0;
+
+    double start = Bench_NowNs();
+    for (int i = 0; i < iterations; i++)
+    {
+        sink += Bench_LinearCollision(segments, length);
+    }
+    double linearNs = (Bench_NowNs() - start) / iterations;
+
+    start = Bench_NowNs();
+    for (int i = 0; i < iterations; i++)
+    {
+        sink += Bench_BitsetCollision(bits, segments[0], columns);
+    }
+    double bitsetNs = (Bench_NowNs() - start) / iterations;
+
+    printf("length %6d: linear %12.2f ns/check, bitset %6.2f ns/check, speedup %9.1fx\n",
+           length, linearNs, bitsetNs, linearNs / bitsetNs);
+
+    (void)sink;
+    free(segments);
+    free(bits);
+}
+
+/*
+ * Program main entry point
+ */
+int main(void)
+{
+    const int lengths[] = { 10, 400, 100000 };
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        Bench_RunLength(lengths[i]);
+    }
+
+    return 0;
+}
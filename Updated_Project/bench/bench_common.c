@@ -0,0 +1,158 @@
+/*
+ * bench_common.c
+ *
+ * Shared helpers for the headless benchmarks
+ * Monotonic timing, board setup, latency percentile reporting and game
+ * state comparison
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "bench_common.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TIMING
+// ============================================================================
+
+/*
+ * Read a monotonic clock in nanoseconds
+ *
+ * @return Current time in nanoseconds since an arbitrary epoch
+ */
+double Bench_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// ============================================================================
+// BOARD SETUP
+// ============================================================================
+
+/*
+ * Grow a snake along a serpentine path until it covers the given number
+ * of cells, and build the matching free-cell index
+ *
+ * @param snake - Snake to build (storage bound by Sim_Create)
+ * @param freeCells - Free-cell index to fill in (storage bound by Sim_Create)
+ * @param length - Target snake length
+ */
+void Bench_FillBoard(Snake* snake, FreeCellSet* freeCells, int length)
+{
+    int columns = Utils_GetGridColumns();
+    int cells = columns * Utils_GetGridRows();
+
+    Snake_Initialize(snake, 0);
+
+    for (int k = 1; k < length; k++)
+    {
+        // Even rows run left to right, odd rows right to left
+        int row = k / columns;
+        bool rowStart = (k % columns) == 0;
+        SimAction action = rowStart ? SIM_ACTION_DOWN
+                         : ((row % 2 == 0) ? SIM_ACTION_RIGHT : SIM_ACTION_LEFT);
+
+        Snake_ProcessInput(snake, action);
+        Snake_UpdatePosition(snake);
+        Snake_Grow(snake);
+    }
+
+    FreeCells_Initialize(freeCells, cells);
+    for (int i = 0; i < (int)snake->length; i++)
+    {
+        FreeCells_Remove(freeCells, Snake_GetSegmentCell(snake, i));
+    }
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+/*
+ * Compare two samples for qsort
+ */
+static int Bench_CompareSamples(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Sort samples in ascending order
+ *
+ * @param samples - Array of samples to sort in place
+ * @param count - Number of samples
+ */
+void Bench_SortSamples(double* samples, int count)
+{
+    assert(samples != NULL);
+
+    qsort(samples, (size_t)count, sizeof(double), Bench_CompareSamples);
+}
+
+/*
+ * Read a percentile from sorted samples (nearest-rank)
+ *
+ * @param sortedSamples - Samples sorted in ascending order
+ * @param count - Number of samples
+ * @param percentile - Percentile in the range [0, 100]
+ * @return Sample value at that percentile
+ */
+double Bench_Percentile(const double* sortedSamples, int count, double percentile)
+{
+    assert(sortedSamples != NULL);
+    assert(count > 0);
+
+    int rank = (int)(percentile / 100.0 * (count - 1) + 0.5);
+    if (rank < 0) rank = 0;
+    if (rank >= count) rank = count - 1;
+
+    return sortedSamples[rank];
+}
+
+// ============================================================================
+// STATE COMPARISON
+// ============================================================================
+
+/*
+ * Compare two games field by field, including the random stream and the
+ * free-list order that decides where the next food spawns
+ *
+ * @param a - First game
+ * @param b - Second game
+ * @return true if both games would continue identically
+ */
+bool Bench_SameSim(const SimState* a, const SimState* b)
+{
+    assert(a != NULL);
+    assert(b != NULL);
+
+    if ((a->score != b->score) || (a->tickCount != b->tickCount) || (a->isDead != b->isDead) ||
+        (a->seed != b->seed) || (a->rng.state != b->rng.state) ||
+        (a->food.active != b->food.active) || (a->food.active && (a->food.cell != b->food.cell)) ||
+        (a->snake.length != b->snake.length) || (a->snake.directionX != b->snake.directionX) ||
+        (a->snake.directionY != b->snake.directionY) || (a->freeCells.count != b->freeCells.count))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < (int)a->snake.length; i++)
+    {
+        if (Snake_GetSegmentCell(&a->snake, i) != Snake_GetSegmentCell(&b->snake, i))
+        {
+            return false;
+        }
+    }
+
+    return memcmp(a->freeCells.cells, b->freeCells.cells,
+                  (size_t)a->freeCells.count * sizeof(a->freeCells.cells[0])) == 0;
+}
@@ -0,0 +1,42 @@
+/*
+ * bench_common.h
+ *
+ * Shared helpers for the headless benchmarks
+ * Monotonic timing, board setup, latency percentile reporting and game
+ * state comparison
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include "../snake_sim.h"
+
+// ============================================================================
+// TIMING FUNCTIONS
+// ============================================================================
+
+double Bench_NowNs(void);
+
+// ============================================================================
+// BOARD SETUP FUNCTIONS
+// ============================================================================
+
+void Bench_FillBoard(Snake* snake, FreeCellSet* freeCells, int length);
+
+// ============================================================================
+// STATISTICS FUNCTIONS
+// ============================================================================
+
+void Bench_SortSamples(double* samples, int count);
+double Bench_Percentile(const double* sortedSamples, int count, double percentile);
+
+// ============================================================================
+// STATE COMPARISON FUNCTIONS
+// ============================================================================
+
+bool Bench_SameSim(const SimState* a, const SimState* b);
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,139 @@
+/*
+ * bench_food.c
+ *
+ * Food spawn latency benchmark
+ * Compares the legacy rejection-sampling spawn (random cell, rescan the
+ * whole snake, retry) against the free-cell index at increasing fill
+ * levels up to 99% of the board
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SPAWN_SAMPLES 20000
+#define BENCH_SEED    12345
+
+static Rng benchRng;
+
+// ============================================================================
+// SPAWN PATHS
+// ============================================================================
+
+/*
+ * Legacy path: draw random cells until one is not covered by any segment
+ * (same rejection loop as before, drawing from the bench rng)
+ */
+static int Bench_LegacySpawn(const Snake* snake)
+{
+    int columns = Utils_GetGridColumns();
+    int rows = Utils_GetGridRows();
+
+    for (;;)
+    {
+        int cell = (int)Rng_NextBounded(&benchRng, (uint32_t)rows) * columns +
+                   (int)Rng_NextBounded(&benchRng, (uint32_t)columns);
+        bool taken = false;
+
+        for (int i = 0; i < (int)snake->length; i++)
+        {
+            if (cell == Snake_GetSegmentCell(snake, i))
+            {
+                taken = true;
+                break;
+            }
+        }
+
+        if (!taken)
+        {
+            return cell;
+        }
+    }
+}
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Print percentile summary for a set of latency samples
+ */
+static void Bench_Report(const char* label, double* samples, int count)
+{
+    Bench_SortSamples(samples, count);
+
+    printf("  %-8s p50 %9.0f ns  p90 %9.0f ns  p99 %9.0f ns  max %9.0f ns\n",
+           label,
+           Bench_Percentile(samples, count, 50.0),
+           Bench_Percentile(samples, count, 90.0),
+           Bench_Percentile(samples, count, 99.0),
+           samples[count - 1]);
+}
+
+/*
+ * Time both spawn paths with the board filled to the given percentage
+ *
+ * @param fillPercent - Share of the board covered by the snake
+ */
+static void Bench_RunFill(int fillPercent)
+{
+    static Arena arena;
+    static SimState sim;
+    static double samples[SPAWN_SAMPLES];
+
+    int cells = Utils_GetGridColumns() * Utils_GetGridRows();
+    int length = cells * fillPercent / 100;
+    if (length < 1) length = 1;
+    if (length > cells - 1) length = cells - 1;
+
+    if ((sim.storage == NULL) && !Sim_Create(&sim, &arena))
+    {
+        fprintf(stderr, "out of memory\n");
+        return;
+    }
+
+    Bench_FillBoard(&sim.snake, &sim.freeCells, length);
+    printf("fill %d%% (%d of %d cells):\n", fillPercent, length, cells);
+
+    volatile int sink = 0;
+
+    for (int i = 0; i < SPAWN_SAMPLES; i++)
+    {
+        double start = Bench_NowNs();
+        sink += Bench_LegacySpawn(&sim.snake);
+        samples[i] = Bench_NowNs() - start;
+    }
+    Bench_Report("legacy", samples, SPAWN_SAMPLES);
+
+    for (int i = 0; i < SPAWN_SAMPLES; i++)
+    {
+        Food food;
+        double start = Bench_NowNs();
+        Food_Spawn(&food, &sim.freeCells, &benchRng);
+        samples[i] = Bench_NowNs() - start;
+        sink += food.cell;
+    }
+    Bench_Report("indexed", samples, SPAWN_SAMPLES);
+
+    (void)sink;
+}
+
+/*
+ * Program main entry point
+ */
+int main(void)
+{
+    const int fillLevels[] = { 10, 50, 90, 99 };
+
+    Rng_Seed(&benchRng, BENCH_SEED, 0);
+
+    for (size_t i = 0; i < sizeof(fillLevels) / sizeof(fillLevels[0]); i++)
+    {
+        Bench_RunFill(fillLevels[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * bench_observation.c
+ *
+ * Observation encoder benchmark
+ * Encodes a stepped batch with every kernel the CPU supports, reports
+ * games encoded per second and output bandwidth for both formats and
+ * checks that each kernel writes the same bytes as the scalar kernel
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ACTION_FRAMES  64
+#define WARMUP_STEPS   500
+#define TOTAL_CELLS    500000000.0    // Cells encoded per measurement
+#define BENCH_SEED     7
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Time one kernel and format, and compare its output with the reference
+ *
+ * @param batch - Stepped batch to encode
+ * @param kernel - Kernel to time
+ * @param format - Output element type
+ * @param out - Output buffer
+ * @param reference - Scalar output to compare with
+ * @return true if the output matches the reference
+ */
+static bool Bench_RunKernel(const SnakeBatch* batch, ObservationKernel kernel,
+                            ObservationFormat format, void* out, const void* reference)
+{
+    size_t size = Observation_GetBatchSize(batch, format);
+    int repeats = (int)(TOTAL_CELLS / ((double)batch->gameCount * batch->cellCount)) + 1;
+
+    Observation_SetKernel(kernel);
+    memset(out, 0xAB, size);
+
+    double start = Bench_NowNs();
+    for (int i = 0; i < repeats; i++)
+    {
+        Observation_EncodeBatch(batch, out, format);
+    }
+    double seconds = (Bench_NowNs() - start) / 1e9;
+
+    bool isMatch = (memcmp(out, reference, size) == 0);
+    double games = (double)repeats * batch->gameCount;
+    printf("  %-6s %-3s: %8.2f ns/game %8.2f GB/s%s\n",
+           Observation_GetKernelName(kernel), (format == OBS_FORMAT_F32) ? "f32" : "u8",
+           seconds * 1e9 / games, (double)size * repeats / seconds / 1e9,
+           isMatch ? "" : "  MISMATCH");
+
+    return isMatch;
+}
+
+/*
+ * Step a batch into a mix of snake lengths and time every kernel on it
+ *
+ * @param gameCount - Number of games
+ * @param columns - Board width
+ * @param rows - Board height
+ * @return true if every kernel matched the scalar kernel
+ */
+static bool Bench_RunBoard(int gameCount, int columns, int rows)
+{
+    SnakeBatch batch;
+    if (!Batch_Create(&batch, gameCount, columns, rows, BENCH_SEED))
+    {
+        fprintf(stderr, "out of memory for %d games\n", gameCount);
+        return false;
+    }
+
+    uint8_t* actions = malloc((size_t)gameCount * ACTION_FRAMES);
+    size_t size = Observation_GetBatchSize(&batch, OBS_FORMAT_F32);
+    void* out = malloc(size);
+    void* reference = malloc(size);
+
+    if (actions == NULL || out == NULL || reference == NULL)
+    {
+        fprintf(stderr, "out of memory for %d games\n", gameCount);
+        free(actions);
+        free(out);
+        free(reference);
+        Batch_Destroy(&batch);
+        return false;
+    }
+
+    for (int i = 0; i < gameCount * ACTION_FRAMES; i++)
+    {
+        actions[i] = (rand() % 4 == 0) ? (uint8_t)(rand() % 5) : SIM_ACTION_NONE;
+    }
+    for (int step = 0; step < WARMUP_STEPS; step++)
+    {
+        Batch_Step(&batch, actions + (size_t)(step % ACTION_FRAMES) * gameCount);
+    }
+
+    printf("%dx%d, %d games:\n", columns, rows, gameCount);
+
+    bool isMatch = true;
+    const ObservationFormat formats[] = { OBS_FORMAT_U8, OBS_FORMAT_F32 };
+    for (int f = 0; f < 2; f++)
+    {
+        Observation_SetKernel(OBS_KERNEL_SCALAR);
+        Observation_EncodeBatch(&batch, reference, formats[f]);
+
+        for (int kernel = 0; kernel < OBS_KERNEL_COUNT; kernel++)
+        {
+            if (Observation_IsKernelSupported(kernel))
+            {
+                isMatch &= Bench_RunKernel(&batch, kernel, formats[f], out, reference);
+            }
+        }
+    }
+
+    free(actions);
+    free(out);
+    free(reference);
+    Batch_Destroy(&batch);
+    return isMatch;
+}
+
+/*
+ * Program main entry point
+ */
+int main(void)
+{
+    // 83 * 83 cells is not a multiple of any vector width, so the tails run too
+    bool isMatch = Bench_RunBoard(4096, 16, 16) & Bench_RunBoard(256, 83, 83);
+
+    if (!isMatch)
+    {
+        fprintf(stderr, "FAIL: kernel output differs from the scalar kernel\n");
+        return 1;
+    }
+
+    return 0;
+}
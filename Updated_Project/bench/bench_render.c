@@ -0,0 +1,233 @@
+/*
+ * bench_render.c
+ *
+ * Software renderer benchmark
+ * Draws a game at the default window size through renderer.c and the
+ * software backend, reports the time per full frame for the incremental
+ * and full redraw paths (with and without the text and fade overlays),
+ * checks that both paths produce the same pixels, and times saving a
+ * frame as PNG and raw RGBA. The last frame is left in bench_frame.png.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "bench_common.h"
+#include "../snake_game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RENDER_FRAMES    2000
+#define FRAMES_PER_TICK  10
+#define WRITE_FRAMES     20
+#define FRAME_BUDGET_NS  1e6      // Full frame budget for dumping every frame
+#define BENCH_SEED       12345
+#define BENCH_FRAME_PATH "bench_frame.png"
+#define BENCH_RAW_PATH   "bench_frame.rgba"
+
+static Arena benchArena;
+
+/*
+ * Render path being timed
+ */
+typedef enum {
+    RENDER_INCREMENTAL = 0,
+    RENDER_FULL,
+    RENDER_FULL_OVERLAYS,
+    RENDER_MODE_COUNT
+} RenderMode;
+
+static const char* modeNames[RENDER_MODE_COUNT] = { "incremental", "full", "full+overlays" };
+
+// ============================================================================
+// FRAME DRAWING
+// ============================================================================
+
+/*
+ * Draw one frame the way Game_Render does for the given path
+ */
+static void Bench_DrawFrame(RenderMode mode, const SimState* sim, Position gridOffset,
+                            float alpha, bool tailMoved)
+{
+    if (mode == RENDER_INCREMENTAL)
+    {
+        Renderer_UpdateBoard(&sim->snake, &sim->food, gridOffset);
+    }
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+
+    if (mode == RENDER_INCREMENTAL)
+    {
+        Renderer_DrawBoard(&sim->snake, &sim->food, gridOffset);
+        Snake_RenderMotion(&sim->snake, gridOffset, alpha, tailMoved);
+    }
+    else
+    {
+        Renderer_DrawGrid(gridOffset);
+        Food_Render(&sim->food, gridOffset);
+        Snake_Render(&sim->snake, gridOffset, alpha, tailMoved);
+    }
+
+    if (mode == RENDER_FULL_OVERLAYS)
+    {
+        Renderer_DrawPauseScreen();
+        Renderer_DrawFreezeEffect();
+        Renderer_DrawFrameTime(16.7f, 0.25);
+        Renderer_DrawInputLatency(12.0, 14.5, 30.0);
+    }
+
+    EndDrawing();
+}
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Time every render path on the same game, and compare the incremental
+ * frames with the full redraw of the same state
+ *
+ * @return true if both paths drew identical frames throughout
+ */
+static bool Bench_RunFrames(void)
+{
+    static double samples[RENDER_MODE_COUNT][RENDER_FRAMES];
+    size_t frameSize = (size_t)GetScreenWidth() * (size_t)GetScreenHeight() * 4;
+    unsigned char* incremental = malloc(frameSize);
+    Position gridOffset = Utils_CalculateGridOffset();
+    Rng rng;
+    SimState sim;
+    bool tailMoved = true;
+    int mismatches = 0;
+
+    if ((incremental == NULL) || !Sim_Create(&sim, &benchArena))
+    {
+        fprintf(stderr, "out of memory for the benchmark\n");
+        exit(1);
+    }
+
+    Rng_Seed(&rng, BENCH_SEED, 0);
+    Sim_Initialize(&sim, BENCH_SEED);
+    Renderer_Initialize(gridOffset);
+    Renderer_InvalidateBoard();
+
+    for (int frame = 0; frame < RENDER_FRAMES; frame++)
+    {
+        int phase = frame % FRAMES_PER_TICK;
+        float alpha = (float)phase / FRAMES_PER_TICK;
+
+        if (phase == 0)
+        {
+            SimAction action = (Rng_NextBounded(&rng, 4) == 0)
+                ? (SimAction)(1 + Rng_NextBounded(&rng, 4)) : SIM_ACTION_NONE;
+            int events = Sim_Step(&sim, action);
+            if (events & SIM_EVENT_DIED)
+            {
+                Sim_Initialize(&sim, BENCH_SEED + (uint64_t)frame);
+                Renderer_InvalidateBoard();
+            }
+            tailMoved = (events & SIM_EVENT_ATE) == 0;
+        }
+
+        for (int mode = 0; mode < RENDER_MODE_COUNT; mode++)
+        {
+            double start = Bench_NowNs();
+            Bench_DrawFrame((RenderMode)mode, &sim, gridOffset, alpha, tailMoved);
+            samples[mode][frame] = Bench_NowNs() - start;
+
+            if (mode == RENDER_INCREMENTAL)
+            {
+                memcpy(incremental, SoftBackend_GetPixels(), frameSize);
+            }
+            else if ((mode == RENDER_FULL) && (memcmp(incremental, SoftBackend_GetPixels(), frameSize) != 0))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    printf("%dx%d window, %dx%d board, %d frames:\n", GetScreenWidth(), GetScreenHeight(),
+           Utils_GetGridColumns(), Utils_GetGridRows(), RENDER_FRAMES);
+    for (int mode = 0; mode < RENDER_MODE_COUNT; mode++)
+    {
+        Bench_SortSamples(samples[mode], RENDER_FRAMES);
+        double p99 = Bench_Percentile(samples[mode], RENDER_FRAMES, 99.0);
+        printf("  %-14s p50 %7.1f us  p99 %7.1f us%s\n", modeNames[mode],
+               Bench_Percentile(samples[mode], RENDER_FRAMES, 50.0) / 1e3, p99 / 1e3,
+               (p99 > FRAME_BUDGET_NS) ? "  OVER BUDGET" : "");
+    }
+
+    free(incremental);
+    Renderer_Cleanup();
+    Arena_Reset(&benchArena);
+
+    if (mismatches > 0)
+    {
+        fprintf(stderr, "incremental and full redraw differ on %d frames\n", mismatches);
+    }
+    return mismatches == 0;
+}
+
+/*
+ * Time saving the current screen in each format
+ *
+ * @return true if every frame was written
+ */
+static bool Bench_RunWrites(void)
+{
+    const char* paths[] = { BENCH_FRAME_PATH, BENCH_RAW_PATH };
+    bool isWritten = true;
+
+    for (int format = 0; format < 2; format++)
+    {
+        double start = Bench_NowNs();
+        for (int i = 0; i < WRITE_FRAMES; i++)
+        {
+            isWritten &= SoftBackend_WriteFrame(paths[format]);
+        }
+        double microseconds = (Bench_NowNs() - start) / WRITE_FRAMES / 1e3;
+
+        FILE* file = fopen(paths[format], "rb");
+        long size = 0;
+        if (file != NULL)
+        {
+            fseek(file, 0, SEEK_END);
+            size = ftell(file);
+            fclose(file);
+        }
+        printf("  write %-4s %8.1f us per frame, %ld bytes\n", (format == 0) ? "png" : "raw",
+               microseconds, size);
+    }
+
+    remove(BENCH_RAW_PATH);
+    return isWritten;
+}
+
+/*
+ * Program main entry point
+ */
+int main(void)
+{
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "bench_render");
+    if (SoftBackend_GetPixels() == NULL)
+    {
+        fprintf(stderr, "out of memory for the screen\n");
+        return 1;
+    }
+
+    bool isMatch = Bench_RunFrames();
+    bool isWritten = Bench_RunWrites();
+
+    CloseWindow();
+    Arena_Destroy(&benchArena);
+
+    if (!isMatch || !isWritten)
+    {
+        fprintf(stderr, "FAIL: %s\n", !isMatch ? "render paths differ" : "cannot write frames");
+        return 1;
+    }
+
+    return 0;
+}
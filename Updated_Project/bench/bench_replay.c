@@ -0,0 +1,114 @@
+/*
+ * bench_replay.c
+ *
+ * Replay round-trip benchmark
+ * Records random games, saves each replay to a file, loads it back and
+ * re-simulates it. Reports the replay size and the cost of each step,
+ * and checks that every replayed game ends in the recorded state.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define GAME_COUNT    300
+#define MAX_TICKS     20000    // Ticks before a recorded game is cut off
+#define BENCH_SEED    12345
+#define REPLAY_PATH   "bench_replay.rep"
+
+static Arena benchArena;   // Both games; the replays use the heap
+static SimState recorded;
+static SimState replayed;
+
+/*
+ * Random policy: mostly straight, one move in four asks for a turn
+ */
+static SimAction Bench_RandomAction(Rng* rng)
+{
+    return (Rng_NextBounded(rng, 4) == 0)
+        ? (SimAction)(1 + Rng_NextBounded(rng, 4))
+        : SIM_ACTION_NONE;
+}
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Program main entry point
+ */
+int main(void)
+{
+    Replay replay;
+    Replay loaded;
+    Rng rng;
+    long long ticks = 0;
+    size_t bytes = 0;
+    double saveNs = 0.0;
+    double loadNs = 0.0;
+    double simulateNs = 0.0;
+    int mismatches = 0;
+
+    if (!Sim_Create(&recorded, &benchArena) || !Sim_Create(&replayed, &benchArena))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    Replay_Initialize(&replay, NULL);
+    Replay_Initialize(&loaded, NULL);
+    Rng_Seed(&rng, BENCH_SEED, 0);
+
+    for (int game = 0; game < GAME_COUNT; game++)
+    {
+        uint64_t seed = BENCH_SEED + (uint64_t)game;
+        bool ok = true;
+
+        Sim_Initialize(&recorded, seed);
+        Replay_Begin(&replay, seed);
+        while (!recorded.isDead && (recorded.tickCount < MAX_TICKS))
+        {
+            SimAction action = Bench_RandomAction(&rng);
+            ok = ok && Replay_RecordAction(&replay, recorded.tickCount, &recorded.snake, action);
+            Sim_Step(&recorded, action);
+        }
+        ok = ok && Replay_Finish(&replay, recorded.tickCount);
+
+        double start = Bench_NowNs();
+        ok = ok && Replay_Save(&replay, REPLAY_PATH);
+        double saved = Bench_NowNs();
+        ok = ok && Replay_Load(&loaded, REPLAY_PATH) && (loaded.tickCount == replay.tickCount);
+        double read = Bench_NowNs();
+        ok = ok && Replay_Simulate(&loaded, &replayed);
+        double simulated = Bench_NowNs();
+
+        saveNs += saved - start;
+        loadNs += read - saved;
+        simulateNs += simulated - read;
+
+        if (!ok || !Bench_SameSim(&recorded, &replayed))
+        {
+            fprintf(stderr, "replay of game %d (seed %llu) does not reproduce it\n",
+                    game, (unsigned long long)seed);
+            mismatches++;
+        }
+        ticks += recorded.tickCount;
+        bytes += replay.size;
+    }
+
+    printf("%d games, %.0f ticks and %.0f turn bytes per game\n",
+           GAME_COUNT, (double)ticks / GAME_COUNT, (double)bytes / GAME_COUNT);
+    printf("save %.1f us, load %.1f us, re-simulate %.1f us per game, %d mismatches\n",
+           saveNs / GAME_COUNT / 1e3, loadNs / GAME_COUNT / 1e3, simulateNs / GAME_COUNT / 1e3,
+           mismatches);
+
+    remove(REPLAY_PATH);
+    Replay_Destroy(&replay);
+    Replay_Destroy(&loaded);
+    Arena_Destroy(&benchArena);
+
+    return mismatches == 0 ? 0 : 1;
+}
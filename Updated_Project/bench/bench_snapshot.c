@@ -0,0 +1,141 @@
+/*
+ * bench_snapshot.c
+ *
+ * Snapshot and restore benchmark
+ * Snapshots random games part way through and keeps playing them, then
+ * restores each snapshot into an unrelated game and replays the same
+ * actions. Reports the snapshot size and the cost of Sim_Snapshot and
+ * Sim_Restore, and checks that every restored game ends exactly like
+ * the original. The original also records its moves in a journal and is
+ * rewound to the snapshot point, which must match the snapshot as well.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define GAME_COUNT     2000
+#define WARMUP_TICKS   500     // Up to this many ticks before the snapshot
+#define REPLAY_TICKS   500     // Ticks stepped after the snapshot and after the restore
+#define BENCH_SEED     12345
+
+static Arena benchArena;   // Both games, the snapshot and the journal
+static SimState original;
+static SimState restored;
+static SimSnapshot snapshot;
+static SimJournal journal;
+
+/*
+ * Random policy: mostly straight, one move in four asks for a turn
+ */
+static SimAction Bench_RandomAction(Rng* rng)
+{
+    return (Rng_NextBounded(rng, 4) == 0)
+        ? (SimAction)(1 + Rng_NextBounded(rng, 4))
+        : SIM_ACTION_NONE;
+}
+
+/*
+ * Step a game a random number of ticks under the random policy
+ */
+static void Bench_Warmup(SimState* sim, Rng* rng)
+{
+    int ticks = (int)Rng_NextBounded(rng, WARMUP_TICKS);
+
+    for (int tick = 0; (tick < ticks) && !sim->isDead; tick++)
+    {
+        Sim_Step(sim, Bench_RandomAction(rng));
+    }
+}
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Program main entry point
+ */
+int main(void)
+{
+    static SimAction actions[REPLAY_TICKS];
+    Rng rng;
+    double snapshotNs = 0.0;
+    double restoreNs = 0.0;
+    double rewindNs = 0.0;
+    int mismatches = 0;
+
+    if (!Sim_Create(&original, &benchArena) || !Sim_Create(&restored, &benchArena) ||
+        !Sim_CreateSnapshot(&snapshot, original.cellCount, &benchArena) ||
+        !Sim_CreateJournal(&journal, REPLAY_TICKS, &benchArena))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    Rng_Seed(&rng, BENCH_SEED, 0);
+
+    for (int game = 0; game < GAME_COUNT; game++)
+    {
+        uint64_t seed = BENCH_SEED + (uint64_t)game;
+
+        // The unrelated game ends up at another length, food and free-list order
+        Sim_Initialize(&restored, ~seed);
+        Bench_Warmup(&restored, &rng);
+        Sim_Initialize(&original, seed);
+        Bench_Warmup(&original, &rng);
+
+        double start = Bench_NowNs();
+        Sim_Snapshot(&original, &snapshot);
+        snapshotNs += Bench_NowNs() - start;
+        Sim_AttachJournal(&original, &journal);
+
+        for (int tick = 0; tick < REPLAY_TICKS; tick++)
+        {
+            actions[tick] = Bench_RandomAction(&rng);
+            Sim_Step(&original, actions[tick]);
+        }
+
+        start = Bench_NowNs();
+        Sim_Restore(&restored, &snapshot);
+        restoreNs += Bench_NowNs() - start;
+
+        for (int tick = 0; tick < REPLAY_TICKS; tick++)
+        {
+            Sim_Step(&restored, actions[tick]);
+        }
+
+        if (!Bench_SameSim(&original, &restored))
+        {
+            fprintf(stderr, "restored game %d (seed %llu) diverges from the original\n",
+                    game, (unsigned long long)seed);
+            mismatches++;
+        }
+
+        // Rewinding the original must land on the snapshot it was taken from
+        start = Bench_NowNs();
+        bool isRewound = Sim_Rewind(&original, 0);
+        rewindNs += Bench_NowNs() - start;
+        Sim_AttachJournal(&original, NULL);
+        Sim_Restore(&restored, &snapshot);
+
+        if (!isRewound || !Bench_SameSim(&original, &restored))
+        {
+            fprintf(stderr, "rewound game %d (seed %llu) differs from its snapshot\n",
+                    game, (unsigned long long)seed);
+            mismatches++;
+        }
+    }
+
+    printf("%d games, snapshot %zu bytes, journal %zu bytes per move\n", GAME_COUNT,
+           Sim_GetSnapshotSize(&snapshot), sizeof(SimUndo));
+    printf("snapshot %.1f ns, restore %.1f ns, rewind of %d moves %.1f ns, %d mismatches\n",
+           snapshotNs / GAME_COUNT, restoreNs / GAME_COUNT, REPLAY_TICKS,
+           rewindNs / GAME_COUNT, mismatches);
+
+    Arena_Destroy(&benchArena);
+
+    return mismatches == 0 ? 0 : 1;
+}
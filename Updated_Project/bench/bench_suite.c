@@ -0,0 +1,764 @@
+/*
+ * bench_suite.c
+ *
+ * Performance gate benchmark suite
+ * Measures tick throughput, food spawn latency by fill level, self
+ * collision cost by length, snapshot/restore/clone cost, multi-snake
+ * match ticks, autopilot decision cost, distance field repairs against
+ * full rebuilds, tree search playouts per move and render submission cost (renderer.c against the null raylib
+ * backend), and prints the results as one JSON document on stdout.
+ * Correctness checks run alongside (match collisions on fixed layouts and
+ * repaired distance fields against rebuilds); a mismatch is reported on
+ * stderr and the exit status is 1.
+ * Usage: bench_suite [--board WxH]   (default board 25x14)
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "bench_common.h"
+#include "../snake_game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_SEED         12345
+#define TICK_COUNT         2000000
+#define SPAWN_SAMPLES      20000
+#define COLLISION_CHECKS   2000000
+#define SNAPSHOT_SAMPLES   20000
+#define SNAPSHOT_MIN_SAMPLES 5
+#define SNAPSHOT_CELL_BUDGET 100000000.0  // Cells copied per fill level
+#define RENDER_FRAMES      20000
+#define FRAMES_PER_TICK    10
+#define MATCH_BOARD_SIZE   512     // Match runs on its own square board
+#define MATCH_TICKS        2000
+#define BOT_BOARD_SIZE     256     // Autopilots run on their own square board
+#define BOT_DECISIONS      20000
+#define PATH_MOVES         20000   // Moves of the path bot the distance field follows
+#define PATH_REBUILD_EVERY 100     // Moves between full rebuilds timed for comparison
+#define MCTS_DECISIONS     200
+#define CHECK_MATCH_BOARD  8       // Square board for the fixed match layouts
+
+static Rng benchRng;
+static Arena benchArena;   // Simulations of the running benchmark
+static int benchFailures;  // Correctness checks that found a mismatch
+
+// ============================================================================
+// SHARED HELPERS
+// ============================================================================
+
+/*
+ * Snake length covering a share of the board, leaving a cell for food
+ */
+static int Bench_LengthForFill(int fillPercent)
+{
+    int cells = Utils_GetCellCount();
+    int length = (int)((long long)cells * fillPercent / 100);
+
+    if (length < 1) length = 1;
+    if (length > cells - 1) length = cells - 1;
+
+    return length;
+}
+
+/*
+ * Create a simulation for the current board, exiting if memory runs out
+ * It lives in benchArena until the benchmark resets the arena
+ */
+static void Bench_CreateSim(SimState* sim)
+{
+    if (!Sim_Create(sim, &benchArena))
+    {
+        fprintf(stderr, "out of memory for a %dx%d board\n",
+                Utils_GetGridColumns(), Utils_GetGridRows());
+        exit(1);
+    }
+}
+
+/*
+ * Build a simulation whose snake covers the given share of the board
+ */
+static void Bench_FillSim(SimState* sim, int fillPercent)
+{
+    Sim_Initialize(sim, BENCH_SEED);
+    Bench_FillBoard(&sim->snake, &sim->freeCells, Bench_LengthForFill(fillPercent));
+    Food_Spawn(&sim->food, &sim->freeCells, &sim->rng);
+}
+
+/*
+ * Random policy: mostly straight, one move in four asks for a turn
+ */
+static SimAction Bench_RandomAction(void)
+{
+    return (Rng_NextBounded(&benchRng, 4) == 0)
+        ? (SimAction)(1 + Rng_NextBounded(&benchRng, 4))
+        : SIM_ACTION_NONE;
+}
+
+/*
+ * Print "p50_ns", "p99_ns" and "max_ns" fields for a set of samples
+ */
+static void Bench_PrintPercentiles(double* samples, int count)
+{
+    Bench_SortSamples(samples, count);
+
+    printf("\"p50_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f",
+           Bench_Percentile(samples, count, 50.0),
+           Bench_Percentile(samples, count, 99.0),
+           samples[count - 1]);
+}
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+
+/*
+ * Sim_Step throughput under a random policy, restarting dead games
+ */
+static void Bench_Tick(void)
+{
+    SimState sim;
+    long long deaths = 0;
+
+    Bench_CreateSim(&sim);
+    Sim_Initialize(&sim, BENCH_SEED);
+
+    double start = Bench_NowNs();
+    for (int i = 0; i < TICK_COUNT; i++)
+    {
+        if (Sim_Step(&sim, Bench_RandomAction()) & SIM_EVENT_DIED)
+        {
+            Sim_Initialize(&sim, BENCH_SEED + (uint64_t)i);
+            deaths++;
+        }
+    }
+    double elapsed = Bench_NowNs() - start;
+
+    printf("  \"tick\": { \"ticks\": %d, \"deaths\": %lld, \"ns_per_tick\": %.2f, "
+           "\"ticks_per_second\": %.0f },\n",
+           TICK_COUNT, deaths, elapsed / TICK_COUNT, TICK_COUNT / (elapsed / 1e9));
+
+    Arena_Reset(&benchArena);
+}
+
+/*
+ * Food_Spawn latency with the board filled to several levels
+ */
+static void Bench_FoodSpawn(void)
+{
+    static const int fillLevels[] = { 10, 50, 90, 99 };
+    static double samples[SPAWN_SAMPLES];
+    int levelCount = (int)(sizeof(fillLevels) / sizeof(fillLevels[0]));
+    SimState sim;
+
+    Bench_CreateSim(&sim);
+
+    printf("  \"food_spawn\": [\n");
+    for (int level = 0; level < levelCount; level++)
+    {
+        Bench_FillSim(&sim, fillLevels[level]);
+
+        for (int i = 0; i < SPAWN_SAMPLES; i++)
+        {
+            double start = Bench_NowNs();
+            Food_Spawn(&sim.food, &sim.freeCells, &benchRng);
+            samples[i] = Bench_NowNs() - start;
+        }
+
+        printf("    { \"fill_percent\": %d, \"length\": %u, ",
+               fillLevels[level], sim.snake.length);
+        Bench_PrintPercentiles(samples, SPAWN_SAMPLES);
+        printf(" }%s\n", (level + 1 < levelCount) ? "," : "");
+    }
+    printf("  ],\n");
+
+    Arena_Reset(&benchArena);
+}
+
+/*
+ * Collision_CheckSnakeWithSelf cost for several snake lengths
+ * Calls are timed in bulk since one check is below clock resolution
+ */
+static void Bench_SelfCollision(void)
+{
+    static const int fillLevels[] = { 1, 10, 50, 99 };
+    int levelCount = (int)(sizeof(fillLevels) / sizeof(fillLevels[0]));
+    volatile int sink = 0;
+    SimState sim;
+
+    Bench_CreateSim(&sim);
+
+    printf("  \"self_collision\": [\n");
+    for (int level = 0; level < levelCount; level++)
+    {
+        Bench_FillSim(&sim, fillLevels[level]);
+
+        double start = Bench_NowNs();
+        for (int i = 0; i < COLLISION_CHECKS; i++)
+        {
+            sink += Collision_CheckSnakeWithSelf(&sim.snake);
+        }
+        double elapsed = Bench_NowNs() - start;
+
+        printf("    { \"length\": %u, \"ns_per_check\": %.2f }%s\n",
+               sim.snake.length, elapsed / COLLISION_CHECKS,
+               (level + 1 < levelCount) ? "," : "");
+    }
+    printf("  ],\n");
+
+    (void)sink;
+    Arena_Reset(&benchArena);
+}
+
+/*
+ * Sim_Snapshot, Sim_Restore and Sim_Copy cost by snake length
+ * Sample count shrinks on large boards to bound the total work
+ */
+static void Bench_Snapshot(void)
+{
+    static const int fillLevels[] = { 1, 50, 99 };
+    static double snapshotSamples[SNAPSHOT_SAMPLES];
+    static double restoreSamples[SNAPSHOT_SAMPLES];
+    static double cloneSamples[SNAPSHOT_SAMPLES];
+    int levelCount = (int)(sizeof(fillLevels) / sizeof(fillLevels[0]));
+    SimState sim;
+    SimState clone;
+    SimSnapshot snapshot;
+
+    Bench_CreateSim(&sim);
+    Bench_CreateSim(&clone);
+    if (!Sim_CreateSnapshot(&snapshot, sim.cellCount, &benchArena))
+    {
+        fprintf(stderr, "out of memory for a snapshot\n");
+        exit(1);
+    }
+
+    int sampleCount = (int)(SNAPSHOT_CELL_BUDGET / sim.cellCount);
+    if (sampleCount > SNAPSHOT_SAMPLES) sampleCount = SNAPSHOT_SAMPLES;
+    if (sampleCount < SNAPSHOT_MIN_SAMPLES) sampleCount = SNAPSHOT_MIN_SAMPLES;
+
+    printf("  \"snapshot\": [\n");
+    for (int level = 0; level < levelCount; level++)
+    {
+        Bench_FillSim(&sim, fillLevels[level]);
+
+        for (int i = 0; i < sampleCount; i++)
+        {
+            double start = Bench_NowNs();
+            Sim_Snapshot(&sim, &snapshot);
+            double snapped = Bench_NowNs();
+            Sim_Restore(&clone, &snapshot);
+            double restored = Bench_NowNs();
+            Sim_Copy(&clone, &sim);
+            double copied = Bench_NowNs();
+
+            snapshotSamples[i] = snapped - start;
+            restoreSamples[i] = restored - snapped;
+            cloneSamples[i] = copied - restored;
+        }
+
+        printf("    { \"length\": %u, \"snapshot_bytes\": %zu, \"state_bytes\": %zu,\n",
+               sim.snake.length,
+               Sim_GetSnapshotSize(&snapshot),
+               sizeof(SimState) + sim.storageSize);
+        printf("      \"snapshot\": { ");
+        Bench_PrintPercentiles(snapshotSamples, sampleCount);
+        printf(" },\n      \"restore\": { ");
+        Bench_PrintPercentiles(restoreSamples, sampleCount);
+        printf(" },\n      \"clone\": { ");
+        Bench_PrintPercentiles(cloneSamples, sampleCount);
+        printf(" } }%s\n", (level + 1 < levelCount) ? "," : "");
+    }
+    printf("  ],\n");
+
+    Arena_Reset(&benchArena);
+}
+
+/*
+ * CPU cost of building one frame with the incremental board or a full
+ * redraw, against the null backend. The game steps once every
+ * FRAMES_PER_TICK frames and the motion fraction sweeps in between,
+ * as in the real loop; restarts after a death are not timed.
+ *
+ * @param useFullRedraw - true for the full redraw path
+ * @param isLast - true if this is the last entry of the list
+ */
+static void Bench_RenderMode(bool useFullRedraw, bool isLast)
+{
+    static double samples[RENDER_FRAMES];
+    Position gridOffset = Utils_CalculateGridOffset();
+    bool tailMoved = true;
+    long drawCalls = 0;
+    SimState sim;
+
+    Bench_CreateSim(&sim);
+    Sim_Initialize(&sim, BENCH_SEED);
+    Renderer_Initialize(gridOffset);
+    Renderer_InvalidateBoard();
+
+    for (int frame = 0; frame < RENDER_FRAMES; frame++)
+    {
+        int phase = frame % FRAMES_PER_TICK;
+        float alpha = (float)phase / FRAMES_PER_TICK;
+
+        if (phase == 0)
+        {
+            int events = Sim_Step(&sim, Bench_RandomAction());
+            if (events & SIM_EVENT_DIED)
+            {
+                Sim_Initialize(&sim, BENCH_SEED + (uint64_t)frame);
+                Renderer_InvalidateBoard();
+            }
+            tailMoved = (events & SIM_EVENT_ATE) == 0;
+        }
+
+        NullBackend_ResetDrawCalls();
+        double start = Bench_NowNs();
+        if (useFullRedraw)
+        {
+            ClearBackground(BLACK);
+            Renderer_DrawGrid(gridOffset);
+            Snake_Render(&sim.snake, gridOffset, alpha, tailMoved);
+            Food_Render(&sim.food, gridOffset);
+        }
+        else
+        {
+            Renderer_UpdateBoard(&sim.snake, &sim.food, gridOffset);
+            ClearBackground(BLACK);
+            Renderer_DrawBoard(&sim.snake, &sim.food, gridOffset);
+            Snake_RenderMotion(&sim.snake, gridOffset, alpha, tailMoved);
+        }
+        samples[frame] = Bench_NowNs() - start;
+        drawCalls += NullBackend_GetDrawCalls();
+    }
+
+    Renderer_Cleanup();
+    Arena_Reset(&benchArena);
+
+    printf("    { \"mode\": \"%s\", \"frames\": %d, \"draw_calls_per_frame\": %.2f, ",
+           useFullRedraw ? "full" : "incremental", RENDER_FRAMES,
+           (double)drawCalls / RENDER_FRAMES);
+    Bench_PrintPercentiles(samples, RENDER_FRAMES);
+    printf(" }%s\n", isLast ? "" : ",");
+}
+
+/*
+ * Match_Step cost with bots steering every snake, by snake count
+ * Bot decisions are timed separately from the step itself
+ */
+static void Bench_Match(void)
+{
+    static const int snakeCounts[] = { 64, 256, 1024 };
+    int countCount = (int)(sizeof(snakeCounts) / sizeof(snakeCounts[0]));
+    int columns = Utils_GetGridColumns();
+    int rows = Utils_GetGridRows();
+
+    Utils_SetBoardSize(MATCH_BOARD_SIZE, MATCH_BOARD_SIZE);
+    printf("  \"match\": [\n");
+
+    for (int level = 0; level < countCount; level++)
+    {
+        int snakeCount = snakeCounts[level];
+        MatchState match;
+        SimAction* actions = Arena_Allocate(&benchArena, (size_t)snakeCount * sizeof(SimAction),
+                                            sizeof(SimAction));
+        if ((actions == NULL) || !Match_Create(&match, &benchArena, snakeCount, snakeCount))
+        {
+            fprintf(stderr, "out of memory for a match\n");
+            exit(1);
+        }
+        Match_Initialize(&match, BENCH_SEED);
+
+        long long deaths = 0;
+        double botNs = 0.0;
+        double stepNs = 0.0;
+        for (int tick = 0; tick < MATCH_TICKS; tick++)
+        {
+            double start = Bench_NowNs();
+            for (int i = 0; i < snakeCount; i++)
+            {
+                actions[i] = Match_ChooseBotAction(&match, i);
+            }
+            double stepStart = Bench_NowNs();
+            deaths += Match_Step(&match, actions);
+            double end = Bench_NowNs();
+
+            botNs += stepStart - start;
+            stepNs += end - stepStart;
+        }
+
+        printf("    { \"snakes\": %d, \"board\": %d, \"ticks\": %d, \"deaths\": %lld, "
+               "\"step_ns_per_tick\": %.0f, \"bot_ns_per_tick\": %.0f }%s\n",
+               snakeCount, MATCH_BOARD_SIZE, MATCH_TICKS, deaths, stepNs / MATCH_TICKS,
+               botNs / MATCH_TICKS, (level + 1 < countCount) ? "," : "");
+
+        Arena_Reset(&benchArena);
+    }
+
+    printf("  ],\n");
+    Utils_SetBoardSize(columns, rows);
+}
+
+/*
+ * Decision cost and score of every built-in bot, restarting finished games
+ */
+static void Bench_Bots(void)
+{
+    static double samples[BOT_DECISIONS];
+    int columns = Utils_GetGridColumns();
+    int rows = Utils_GetGridRows();
+
+    Utils_SetBoardSize(BOT_BOARD_SIZE, BOT_BOARD_SIZE);
+    printf("  \"bots\": [\n");
+
+    for (int bot = 0; bot < CONTROLLER_BOT_COUNT; bot++)
+    {
+        SimState sim;
+        Controller controller;
+
+        Bench_CreateSim(&sim);
+        if (!Controller_CreateBot(&controller, (ControllerBot)bot, &benchArena))
+        {
+            fprintf(stderr, "out of memory for a bot\n");
+            exit(1);
+        }
+        Sim_Initialize(&sim, BENCH_SEED);
+
+        long long games = 0;
+        long long scoreSum = 0;
+        double totalNs = 0.0;
+        for (int i = 0; i < BOT_DECISIONS; i++)
+        {
+            double start = Bench_NowNs();
+            SimAction action = Controller_Decide(&controller, &sim);
+            samples[i] = Bench_NowNs() - start;
+            totalNs += samples[i];
+
+            Sim_Step(&sim, action);
+            if (sim.isDead || !sim.food.active)
+            {
+                scoreSum += sim.score;
+                games++;
+                Sim_Initialize(&sim, BENCH_SEED + (uint64_t)i);
+            }
+        }
+
+        printf("    { \"bot\": \"%s\", \"board\": %d, \"decisions\": %d, \"games\": %lld, "
+               "\"mean_score\": %.1f, \"mean_ns\": %.1f, ",
+               Controller_GetBotName((ControllerBot)bot), BOT_BOARD_SIZE, BOT_DECISIONS, games,
+               (games > 0) ? (double)scoreSum / games : (double)sim.score,
+               totalNs / BOT_DECISIONS);
+        Bench_PrintPercentiles(samples, BOT_DECISIONS);
+        printf(" }%s\n", (bot + 1 < CONTROLLER_BOT_COUNT) ? "," : "");
+
+        Arena_Reset(&benchArena);
+    }
+
+    printf("  ],\n");
+    Utils_SetBoardSize(columns, rows);
+}
+
+/*
+ * Distance field cost per move on the autopilot board: the repair after
+ * a move without eating, the repair after a meal (which moves the food)
+ * and a full rebuild of the same field. Every rebuild must match the
+ * repaired field cell for cell.
+ */
+static void Bench_PathField(void)
+{
+    static double samples[PATH_MOVES];
+    static double mealSamples[PATH_MOVES];
+    int columns = Utils_GetGridColumns();
+    int rows = Utils_GetGridRows();
+    SimState sim;
+    Controller controller;
+    PathField field;
+    PathField rebuilt;
+
+    Utils_SetBoardSize(BOT_BOARD_SIZE, BOT_BOARD_SIZE);
+    Bench_CreateSim(&sim);
+    if (!Controller_CreateBot(&controller, CONTROLLER_BOT_PATH, &benchArena) ||
+        !Path_Create(&field, &benchArena) || !Path_Create(&rebuilt, &benchArena))
+    {
+        fprintf(stderr, "out of memory for the distance field\n");
+        exit(1);
+    }
+    Sim_Initialize(&sim, BENCH_SEED);
+    Path_Update(&field, &sim);
+
+    size_t fieldBytes = (size_t)field.cellCount * sizeof(uint32_t);
+    int repairs = 0;
+    int meals = 0;
+    int rebuilds = 0;
+    int mismatches = 0;
+    long long changedCells = 0;
+    double rebuildNs = 0.0;
+    for (int i = 0; i < PATH_MOVES; i++)
+    {
+        int events = Sim_Step(&sim, Controller_Decide(&controller, &sim));
+        if ((events & SIM_EVENT_DIED) || !sim.food.active)
+        {
+            Sim_Initialize(&sim, BENCH_SEED + (uint64_t)i);
+            Path_Update(&field, &sim);
+            continue;
+        }
+
+        double start = Bench_NowNs();
+        Path_Update(&field, &sim);
+        double elapsed = Bench_NowNs() - start;
+        if (!(events & SIM_EVENT_ATE))
+        {
+            samples[repairs++] = elapsed;
+            changedCells += field.changedCount;
+        }
+        else
+        {
+            mealSamples[meals++] = elapsed;
+        }
+
+        if (i % PATH_REBUILD_EVERY == 0)
+        {
+            rebuilt.isCurrent = false;
+            start = Bench_NowNs();
+            Path_Update(&rebuilt, &sim);
+            rebuildNs += Bench_NowNs() - start;
+            rebuilds++;
+
+            if (memcmp(field.distance, rebuilt.distance, fieldBytes) != 0)
+            {
+                fprintf(stderr, "repaired distance field differs from a rebuild after move %d\n", i);
+                mismatches++;
+            }
+        }
+    }
+
+    printf("  \"path_field\": { \"board\": %d, \"repairs\": %d, \"cells_changed\": %.1f, "
+           "\"rebuild_ns\": %.0f, \"mismatches\": %d, ",
+           BOT_BOARD_SIZE, repairs, (repairs > 0) ? (double)changedCells / repairs : 0.0,
+           (rebuilds > 0) ? rebuildNs / rebuilds : 0.0, mismatches);
+    Bench_PrintPercentiles(samples, repairs);
+    printf(",\n    \"meals\": %d, \"meal\": { ", meals);
+    Bench_PrintPercentiles(mealSamples, meals);
+    printf(" } },\n");
+
+    Arena_Reset(&benchArena);
+    Utils_SetBoardSize(columns, rows);
+    benchFailures += (mismatches > 0);
+}
+
+/*
+ * Tree search playouts and wall time per move at the default budget,
+ * playing one game on the benchmark board
+ */
+static void Bench_Mcts(void)
+{
+    static double samples[MCTS_DECISIONS];
+    SimState sim;
+    MctsAgent agent;
+
+    Bench_CreateSim(&sim);
+    if (!Mcts_Create(&agent, &benchArena, MCTS_DEFAULT_BUDGET_US, NULL))
+    {
+        fprintf(stderr, "out of memory for tree search\n");
+        exit(1);
+    }
+    Sim_Initialize(&sim, BENCH_SEED);
+
+    long long playouts = 0;
+    for (int i = 0; i < MCTS_DECISIONS; i++)
+    {
+        double start = Bench_NowNs();
+        SimAction action = Mcts_Decide(&agent, &sim);
+        samples[i] = Bench_NowNs() - start;
+        playouts += agent.lastPlayoutCount;
+
+        if (Sim_Step(&sim, action) & SIM_EVENT_DIED)
+        {
+            Sim_Initialize(&sim, BENCH_SEED + (uint64_t)i);
+        }
+    }
+
+    printf("  \"mcts\": { \"budget_us\": %d, \"decisions\": %d, \"playouts_per_decision\": %.0f, ",
+           MCTS_DEFAULT_BUDGET_US, MCTS_DECISIONS, (double)playouts / MCTS_DECISIONS);
+    Bench_PrintPercentiles(samples, MCTS_DECISIONS);
+    printf(" },\n");
+
+    Arena_Reset(&benchArena);
+}
+
+/*
+ * Render submission cost for both draw paths
+ */
+static void Bench_Render(void)
+{
+    printf("  \"render\": [\n");
+    Bench_RenderMode(false, false);
+    Bench_RenderMode(true, true);
+    printf("  ]\n");
+}
+
+// ============================================================================
+// CORRECTNESS CHECKS
+// ============================================================================
+
+/*
+ * Lay a match snake on the board, cells listed from tail to head
+ *
+ * @param match - Match whose board is being laid out
+ * @param index - Snake to place
+ * @param cells - Body cells from the tail to the head
+ * @param length - Number of cells
+ * @param action - Heading the snake arrived with
+ */
+static void Bench_PlaceMatchSnake(MatchState* match, int index, const uint32_t* cells, int length,
+                                  SimAction action)
+{
+    MatchSnake* snake = &match->snakes[index];
+
+    memset(snake, 0, sizeof(MatchSnake));
+    for (int i = 0; i < length; i++)
+    {
+        match->owner[cells[i]] = (uint16_t)(index + 1);
+        match->nextCell[cells[i]] = (i + 1 < length) ? cells[i + 1] : cells[i];
+        FreeCells_Remove(&match->freeCells, (int)cells[i]);
+    }
+
+    snake->tailCell = cells[0];
+    snake->headCell = cells[length - 1];
+    snake->length = (uint32_t)length;
+    snake->directionX = (int8_t)((action == SIM_ACTION_RIGHT) - (action == SIM_ACTION_LEFT));
+    snake->directionY = (int8_t)((action == SIM_ACTION_DOWN) - (action == SIM_ACTION_UP));
+    snake->isAlive = true;
+    match->aliveCount++;
+}
+
+/*
+ * Empty a two-snake match and put its one food item in the far corner
+ */
+static void Bench_ClearMatch(MatchState* match)
+{
+    uint32_t foodCell = (uint32_t)(match->cellCount - 1);
+
+    memset(match->owner, 0, (size_t)match->cellCount * sizeof(uint16_t));
+    FreeCells_Initialize(&match->freeCells, match->cellCount);
+    match->aliveCount = 0;
+
+    match->foods[0].cell = foodCell;
+    match->foods[0].active = true;
+    match->owner[foodCell] = MATCH_CELL_FOOD;
+    match->nextCell[foodCell] = 0;
+    FreeCells_Remove(&match->freeCells, (int)foodCell);
+}
+
+/*
+ * Match_Step on fixed layouts where a tail is entered on the same tick a
+ * head is: a snake chasing the tail of a longer snake whose head runs
+ * into it must survive (only the longer snake dies, on the chaser's
+ * neck), while two one-cell snakes swapping cells is head-on and kills
+ * both
+ */
+static void Bench_CheckMatch(void)
+{
+    // A: (1,1) (1,2) (2,2) (3,2) (3,1), heading up; B: (2,0) (2,1), heading down
+    static const uint32_t longSnake[] = { 9, 17, 18, 19, 11 };
+    static const uint32_t chaser[] = { 2, 10 };
+    static const uint32_t swapLeft[] = { 9 };
+    static const uint32_t swapRight[] = { 10 };
+    static const SimAction bothLeft[] = { SIM_ACTION_LEFT, SIM_ACTION_LEFT };
+    static const SimAction swap[] = { SIM_ACTION_RIGHT, SIM_ACTION_LEFT };
+    int columns = Utils_GetGridColumns();
+    int rows = Utils_GetGridRows();
+    int mismatches = 0;
+    MatchState match;
+
+    Utils_SetBoardSize(CHECK_MATCH_BOARD, CHECK_MATCH_BOARD);
+    if (!Match_Create(&match, &benchArena, 2, 1))
+    {
+        fprintf(stderr, "out of memory for a match\n");
+        exit(1);
+    }
+
+    // A turns left into B's head while B turns left into A's tail
+    Bench_ClearMatch(&match);
+    Bench_PlaceMatchSnake(&match, 0, longSnake, 5, SIM_ACTION_UP);
+    Bench_PlaceMatchSnake(&match, 1, chaser, 2, SIM_ACTION_DOWN);
+    int deaths = Match_Step(&match, bothLeft);
+    if ((deaths != 1) || match.snakes[0].isAlive || !match.snakes[1].isAlive ||
+        (match.snakes[1].headCell != longSnake[0]))
+    {
+        fprintf(stderr, "tail chase: the chasing snake must survive and the longer one die\n");
+        mismatches++;
+    }
+
+    // One-cell snakes side by side move into each other
+    Bench_ClearMatch(&match);
+    Bench_PlaceMatchSnake(&match, 0, swapLeft, 1, SIM_ACTION_RIGHT);
+    Bench_PlaceMatchSnake(&match, 1, swapRight, 1, SIM_ACTION_LEFT);
+    deaths = Match_Step(&match, swap);
+    if ((deaths != 2) || match.snakes[0].isAlive || match.snakes[1].isAlive)
+    {
+        fprintf(stderr, "head-on swap: both one-cell snakes must die\n");
+        mismatches++;
+    }
+
+    printf("  \"match_check\": { \"layouts\": 2, \"mismatches\": %d },\n", mismatches);
+
+    Arena_Reset(&benchArena);
+    Utils_SetBoardSize(columns, rows);
+    benchFailures += (mismatches > 0);
+}
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Program main entry point
+ */
+int main(int argc, char** argv)
+{
+    int columns = DEFAULT_GRID_COLUMNS;
+    int rows = DEFAULT_GRID_ROWS;
+
+    if ((argc == 3) && (strcmp(argv[1], "--board") == 0) &&
+        (sscanf(argv[2], "%dx%d", &columns, &rows) != 2))
+    {
+        columns = 0;
+    }
+
+    if (!Utils_SetBoardSize(columns, rows))
+    {
+        fprintf(stderr, "board must be %d to %d cells per side\n", BOARD_MIN_SIZE, BOARD_MAX_SIZE);
+        return 1;
+    }
+
+    Rng_Seed(&benchRng, BENCH_SEED, 0);
+
+    printf("{\n");
+    printf("  \"board\": { \"columns\": %d, \"rows\": %d },\n",
+           Utils_GetGridColumns(), Utils_GetGridRows());
+
+    Bench_Tick();
+    Bench_FoodSpawn();
+    Bench_SelfCollision();
+    Bench_Snapshot();
+    Bench_Match();
+    Bench_Bots();
+    Bench_PathField();
+    Bench_Mcts();
+    Bench_CheckMatch();
+    Bench_Render();
+
+    printf("}\n");
+
+    Arena_Destroy(&benchArena);
+
+    if (benchFailures > 0)
+    {
+        fprintf(stderr, "FAIL: %d correctness check(s) found mismatches\n", benchFailures);
+        return 1;
+    }
+
+    return 0;
+}
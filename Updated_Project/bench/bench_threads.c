@@ -0,0 +1,149 @@
+/*
+ * bench_threads.c
+ *
+ * Parallel batch scaling benchmark
+ * Steps the same batch with 1..N worker threads, reports env-steps per
+ * second for each and checks that every thread count ends in the same
+ * state as the single-threaded run
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define BOARD_SIZE     16
+#define GAME_COUNT     16384
+#define ACTION_FRAMES  64
+#define STEP_COUNT     2000
+#define BENCH_SEED     12345
+
+// ============================================================================
+// STATE CHECKSUM
+// ============================================================================
+
+/*
+ * Hash the per-game state of a batch (FNV-1a over heads, lengths,
+ * scores and food)
+ *
+ * @param batch - Pointer to batch
+ * @return 64-bit checksum
+ */
+static uint64_t Bench_Checksum(const SnakeBatch* batch)
+{
+    uint64_t hash = 1469598103934665603ULL;
+
+    for (int game = 0; game < batch->gameCount; game++)
+    {
+        uint64_t values[] = {
+            batch->headX[game], batch->headY[game], batch->length[game],
+            (uint64_t)batch->score[game], batch->foodCell[game]
+        };
+
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+        {
+            hash = (hash ^ values[i]) * 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
+
+// ============================================================================
+// BENCHMARK DRIVER
+// ============================================================================
+
+/*
+ * Time Batch_StepParallel with a given number of threads
+ *
+ * @param threadCount - Worker count including the calling thread
+ * @param actions - Pre-generated actions, ACTION_FRAMES rows of GAME_COUNT
+ * @param checksum - Receives the final state checksum
+ * @return Env-steps per second, or 0 on failure
+ */
+static double Bench_RunThreads(int threadCount, const uint8_t* actions, uint64_t* checksum)
+{
+    SnakeBatch batch;
+    ThreadPool* pool = ThreadPool_Create(threadCount);
+
+    if (pool == NULL || !Batch_Create(&batch, GAME_COUNT, BOARD_SIZE, BOARD_SIZE, BENCH_SEED))
+    {
+        fprintf(stderr, "could not set up %d threads\n", threadCount);
+        ThreadPool_Destroy(pool);
+        return 0.0;
+    }
+
+    double start = Bench_NowNs();
+    for (int step = 0; step < STEP_COUNT; step++)
+    {
+        Batch_StepParallel(&batch, actions + (size_t)(step % ACTION_FRAMES) * GAME_COUNT, pool);
+    }
+    double seconds = (Bench_NowNs() - start) / 1e9;
+
+    *checksum = Bench_Checksum(&batch);
+
+    Batch_Destroy(&batch);
+    ThreadPool_Destroy(pool);
+
+    return (double)STEP_COUNT * GAME_COUNT / seconds;
+}
+
+/*
+ * Program main entry point
+ * An optional argument overrides the maximum thread count
+ */
+int main(int argc, char** argv)
+{
+    long maxThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc > 1)
+    {
+        maxThreads = strtol(argv[1], NULL, 10);
+    }
+    if (maxThreads < 1)
+    {
+        maxThreads = 1;
+    }
+
+    uint8_t* actions = malloc((size_t)GAME_COUNT * ACTION_FRAMES);
+    if (actions == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (int i = 0; i < GAME_COUNT * ACTION_FRAMES; i++)
+    {
+        actions[i] = (rand() % 4 == 0) ? (uint8_t)(rand() % 5) : SIM_ACTION_NONE;
+    }
+
+    uint64_t reference = 0;
+    double baseline = 0.0;
+    int mismatches = 0;
+
+    for (int threads = 1; threads <= maxThreads; threads++)
+    {
+        uint64_t checksum = 0;
+        double rate = Bench_RunThreads(threads, actions, &checksum);
+
+        if (threads == 1)
+        {
+            reference = checksum;
+            baseline = rate;
+        }
+
+        bool same = (checksum == reference);
+        mismatches += !same;
+
+        printf("threads %3d: %8.2f M env-steps/s  speedup %5.2fx  state %016llx %s\n",
+               threads, rate / 1e6, baseline > 0.0 ? rate / baseline : 0.0,
+               (unsigned long long)checksum, same ? "ok" : "MISMATCH");
+    }
+
+    free(actions);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+/*
+ * raylib.h (null backend)
+ *
+ * Stand-in for the raylib header used by the benchmark suite
+ * Declares only the types and calls renderer.c uses; the matching
+ * raylib_null.c turns every draw into a counted no-op so render
+ * submission cost can be measured without a window or GPU
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#ifndef RAYLIB_H
+#define RAYLIB_H
+
+#include <stdbool.h>
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+typedef struct Vector2 { float x; float y; } Vector2;
+typedef struct Color { unsigned char r; unsigned char g; unsigned char b; unsigned char a; } Color;
+typedef struct Rectangle { float x; float y; float width; float height; } Rectangle;
+
+typedef struct Texture {
+    unsigned int id;
+    int width;
+    int height;
+    int mipmaps;
+    int format;
+} Texture;
+typedef Texture Texture2D;
+
+typedef struct RenderTexture {
+    unsigned int id;
+    Texture texture;
+    Texture depth;
+} RenderTexture;
+typedef RenderTexture RenderTexture2D;
+
+// ============================================================================
+// COLORS
+// ============================================================================
+
+#define LIGHTGRAY  (Color){ 200, 200, 200, 255 }
+#define GRAY       (Color){ 130, 130, 130, 255 }
+#define YELLOW     (Color){ 253, 249, 0, 255 }
+#define RED        (Color){ 230, 41, 55, 255 }
+#define GREEN      (Color){ 0, 228, 48, 255 }
+#define SKYBLUE    (Color){ 102, 191, 255, 255 }
+#define BLUE       (Color){ 0, 121, 241, 255 }
+#define WHITE      (Color){ 255, 255, 255, 255 }
+#define BLACK      (Color){ 0, 0, 0, 255 }
+
+// ============================================================================
+// WINDOW AND DRAWING FUNCTIONS
+// ============================================================================
+
+int GetScreenWidth(void);
+int GetScreenHeight(void);
+void ClearBackground(Color color);
+void BeginTextureMode(RenderTexture2D target);
+void EndTextureMode(void);
+RenderTexture2D LoadRenderTexture(int width, int height);
+void UnloadRenderTexture(RenderTexture2D target);
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint);
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color);
+void DrawRectangle(int posX, int posY, int width, int height, Color color);
+void DrawRectangleV(Vector2 position, Vector2 size, Color color);
+void DrawRectangleRec(Rectangle rec, Color color);
+void DrawText(const char* text, int posX, int posY, int fontSize, Color color);
+int MeasureText(const char* text, int fontSize);
+const char* TextFormat(const char* text, ...);
+Color Fade(Color color, float alpha);
+
+// ============================================================================
+// NULL BACKEND FUNCTIONS
+// ============================================================================
+
+void NullBackend_ResetDrawCalls(void);
+long NullBackend_GetDrawCalls(void);
+
+#endif // RAYLIB_H
@@ -0,0 +1,155 @@
+/*
+ * raylib_null.c
+ *
+ * Null raylib backend for the benchmark suite
+ * Every draw call only bumps a counter, so timing the renderer against
+ * it measures the CPU cost of building and submitting a frame
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "raylib.h"
+#include "../../snake_sim.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static long drawCalls = 0;
+static unsigned int nextTextureId = 1;
+
+// ============================================================================
+// DRAW CALL COUNTER
+// ============================================================================
+
+/*
+ * Reset the number of draw calls submitted
+ */
+void NullBackend_ResetDrawCalls(void)
+{
+    drawCalls = 0;
+}
+
+/*
+ * Get the number of draw calls submitted since the last reset
+ *
+ * @return Draw call count
+ */
+long NullBackend_GetDrawCalls(void)
+{
+    return drawCalls;
+}
+
+// ============================================================================
+// WINDOW AND TEXTURES
+// ============================================================================
+
+int GetScreenWidth(void)
+{
+    return SCREEN_WIDTH;
+}
+
+int GetScreenHeight(void)
+{
+    return SCREEN_HEIGHT;
+}
+
+RenderTexture2D LoadRenderTexture(int width, int height)
+{
+    RenderTexture2D target;
+
+    memset(&target, 0, sizeof(target));
+    target.id = nextTextureId++;
+    target.texture.id = target.id;
+    target.texture.width = width;
+    target.texture.height = height;
+
+    return target;
+}
+
+void UnloadRenderTexture(RenderTexture2D target)
+{
+    (void)target;
+}
+
+void BeginTextureMode(RenderTexture2D target)
+{
+    (void)target;
+}
+
+void EndTextureMode(void)
+{
+}
+
+// ============================================================================
+// DRAWING
+// ============================================================================
+
+void ClearBackground(Color color)
+{
+    (void)color;
+    drawCalls++;
+}
+
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint)
+{
+    (void)texture; (void)source; (void)position; (void)tint;
+    drawCalls++;
+}
+
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color)
+{
+    (void)startPos; (void)endPos; (void)color;
+    drawCalls++;
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    (void)posX; (void)posY; (void)width; (void)height; (void)color;
+    drawCalls++;
+}
+
+void DrawRectangleV(Vector2 position, Vector2 size, Color color)
+{
+    (void)position; (void)size; (void)color;
+    drawCalls++;
+}
+
+void DrawRectangleRec(Rectangle rec, Color color)
+{
+    (void)rec; (void)color;
+    drawCalls++;
+}
+
+void DrawText(const char* text, int posX, int posY, int fontSize, Color color)
+{
+    (void)text; (void)posX; (void)posY; (void)fontSize; (void)color;
+    drawCalls++;
+}
+
+// ============================================================================
+// TEXT AND COLOR HELPERS
+// ============================================================================
+
+int MeasureText(const char* text, int fontSize)
+{
+    return (int)strlen(text) * fontSize / 2;
+}
+
+const char* TextFormat(const char* text, ...)
+{
+    static char buffer[256];
+    va_list args;
+
+    va_start(args, text);
+    vsnprintf(buffer, sizeof(buffer), text, args);
+    va_end(args);
+
+    return buffer;
+}
+
+Color Fade(Color color, float alpha)
+{
+    color.a = (unsigned char)(alpha * 255.0f);
+    return color;
+}
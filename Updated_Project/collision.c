@@ -8,7 +8,7 @@
  * Date: February 2026
  */
 
-#include "snake_game.h"
+#include "snake_sim.h"
 #include <assert.h>
 
 // ============================================================================
@@ -32,8 +32,7 @@ bool Collision_CheckSnakeWithFood(const Snake* snake, const Food* food)
         return false;
     }
     
-    return (snake->segments[0].position.x == food->position.x) &&
-           (snake->segments[0].position.y == food->position.y);
+    return (uint32_t)Snake_GetSegmentCell(snake, 0) == food->cell;
 }
 
 /*
@@ -0,0 +1,724 @@
+/*
+ * controller.c
+ *
+ * Controller module
+ * A controller picks the action for every move. The keyboard is one
+ * controller (see game.c); this module adds the built-in autopilots used
+ * for soak testing and as baseline opponents:
+ *   greedy - step toward the food, avoiding the body
+ *   path   - A* path to the food, taken only if the snake can still
+ *            reach its tail after eating
+ *   cycle  - follow a Hamiltonian cycle of the board, cutting corners
+ *            while the snake is short, so it can fill the whole board
+ * Searches treat the body as walls that open up as the tail moves on:
+ * segment i (0 for the head) leaves its cell length - i moves from now.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <string.h>
+
+#define CONTROLLER_NO_CELL       UINT32_MAX
+#define CONTROLLER_BUCKETS       3   // A* cost estimates rise by at most 2 per move
+#define CYCLE_SHORTCUT_MAX_FILL  50  // Board percentage the cycle bot stops cutting corners at
+#define CYCLE_SHORTCUT_MARGIN    2   // Free cells a shortcut leaves in front of the tail
+
+/*
+ * Where a search stopped
+ */
+typedef struct {
+    uint32_t cell;      // Cell found, or CONTROLLER_NO_CELL
+    uint32_t distance;  // Moves to reach it
+    int reached;        // Cells reached before stopping
+} ControllerSearch;
+
+static const char* const botNames[CONTROLLER_BOT_COUNT] = {
+    "greedy",
+    "path",
+    "cycle"
+};
+
+// Opposite of each SimAction (SIM_ACTION_NONE has none)
+static const SimAction reverseAction[] = {
+    SIM_ACTION_NONE, SIM_ACTION_DOWN, SIM_ACTION_UP, SIM_ACTION_RIGHT, SIM_ACTION_LEFT
+};
+
+// ============================================================================
+// BOARD HELPERS
+// ============================================================================
+
+/*
+ * Get the four cells next to a cell, indexed by SimAction - 1
+ */
+static void Controller_GetNeighbors(const Controller* controller, uint32_t cell, uint32_t neighbors[4])
+{
+    Utils_GetNeighborCells(controller->columns, controller->cellCount, cell, neighbors);
+}
+
+/*
+ * Distance between two cells with wrap-around on both axes
+ */
+static uint32_t Controller_GetDistance(const Controller* controller, uint32_t from, uint32_t to)
+{
+    int columns = controller->columns;
+    int dx = (int)(from % (uint32_t)columns) - (int)(to % (uint32_t)columns);
+    int dy = (int)(from / (uint32_t)columns) - (int)(to / (uint32_t)columns);
+
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    if (dx > columns - dx) dx = columns - dx;
+    if (dy > controller->rows - dy) dy = controller->rows - dy;
+
+    return (uint32_t)(dx + dy);
+}
+
+/*
+ * Get the action that would turn the snake back on itself
+ *
+ * @param snake - Snake to check
+ * @return Reversing action (Snake_ProcessInput ignores it)
+ */
+static SimAction Controller_GetReverseAction(const Snake* snake)
+{
+    if (snake->directionX > 0) return SIM_ACTION_LEFT;
+    if (snake->directionX < 0) return SIM_ACTION_RIGHT;
+    if (snake->directionY > 0) return SIM_ACTION_UP;
+    if (snake->directionY < 0) return SIM_ACTION_DOWN;
+
+    return SIM_ACTION_NONE;
+}
+
+/*
+ * Get the action that moves the head onto a neighboring cell
+ * The reversing action is never returned: on a board two cells wide both
+ * sideways moves reach the same cell and only one of them is legal
+ *
+ * @param controller - Controller sized to the board
+ * @param snake - Snake to steer
+ * @param cell - Cell next to the head
+ * @return Action, or SIM_ACTION_NONE if no legal move reaches cell
+ */
+static SimAction Controller_GetActionTowards(const Controller* controller, const Snake* snake,
+                                            uint32_t cell)
+{
+    uint32_t neighbors[4];
+    SimAction reverse = Controller_GetReverseAction(snake);
+
+    Controller_GetNeighbors(controller, snake->body[snake->headIndex], neighbors);
+    for (int i = 0; i < 4; i++)
+    {
+        SimAction action = (SimAction)(i + 1);
+        if ((action != reverse) && (neighbors[i] == cell))
+        {
+            return action;
+        }
+    }
+
+    return SIM_ACTION_NONE;
+}
+
+/*
+ * Start a new generation of stamps; all cells become unmarked
+ * Stamps are cleared only when the generation counter wraps
+ *
+ * @param generation - Generation counter
+ * @param stamps - Stamp of every cell
+ * @param cellCount - Number of cells
+ * @return The new generation
+ */
+static uint32_t Controller_NextGeneration(uint32_t* generation, uint32_t* stamps, int cellCount)
+{
+    if (++*generation == 0)
+    {
+        memset(stamps, 0, (size_t)cellCount * sizeof(uint32_t));
+        *generation = 1;
+    }
+
+    return *generation;
+}
+
+// ============================================================================
+// BLOCK MAP
+// ============================================================================
+
+/*
+ * Mark a cell as covered for the next movesUntilFree - 1 moves
+ */
+static void Controller_BlockCell(Controller* controller, uint32_t cell, uint32_t movesUntilFree)
+{
+    controller->blockStamp[cell] = controller->blockGeneration;
+    controller->blockedUntil[cell] = movesUntilFree;
+}
+
+/*
+ * Check whether the head can enter a cell on a given move
+ *
+ * @param controller - Controller with a block map
+ * @param cell - Cell to enter
+ * @param distance - Move number, 1 for the next move
+ * @return true if no segment covers the cell by then
+ */
+static bool Controller_IsOpen(const Controller* controller, uint32_t cell, uint32_t distance)
+{
+    return (controller->blockStamp[cell] != controller->blockGeneration) ||
+           (controller->blockedUntil[cell] <= distance);
+}
+
+/*
+ * Check whether a body segment has already left a cell by a given move
+ * From such a cell the head can follow the body's trail indefinitely
+ */
+static bool Controller_IsVacated(const Controller* controller, uint32_t cell, uint32_t distance)
+{
+    return (controller->blockStamp[cell] == controller->blockGeneration) &&
+           (controller->blockedUntil[cell] <= distance);
+}
+
+/*
+ * Block map of the snake as it is now
+ * The snake's occupancy bitset says which cells are covered but not for
+ * how many more moves, and Controller_BlockBodyAfterPath maps a body the
+ * snake does not have yet, so searches test walls against this map.
+ *
+ * @param controller - Controller with search buffers
+ * @param snake - Snake to map
+ */
+static void Controller_BlockBody(Controller* controller, const Snake* snake)
+{
+    Controller_NextGeneration(&controller->blockGeneration, controller->blockStamp,
+                              controller->cellCount);
+
+    for (uint32_t segment = 0; segment < snake->length; segment++)
+    {
+        Controller_BlockCell(controller, (uint32_t)Snake_GetSegmentCell(snake, (int)segment),
+                             snake->length - segment);
+    }
+}
+
+/*
+ * Block map of the snake once it has followed a path and eaten
+ * The path (food back to the head through parent[]) becomes the front
+ * of the body, followed by as much of the old body as the grown snake
+ * still covers
+ *
+ * @param controller - Controller holding the path in parent[]
+ * @param snake - Snake before the path
+ * @param food - Food cell at the end of the path
+ * @param pathLength - Moves from the head to the food
+ * @return Tail cell of the grown snake
+ */
+static uint32_t Controller_BlockBodyAfterPath(Controller* controller, const Snake* snake,
+                                              uint32_t food, uint32_t pathLength)
+{
+    uint32_t length = snake->length + 1;
+    uint32_t cell = food;
+    uint32_t tail = food;
+    uint32_t segment = 0;
+
+    Controller_NextGeneration(&controller->blockGeneration, controller->blockStamp,
+                              controller->cellCount);
+
+    for (; (segment < pathLength) && (segment < length); segment++)
+    {
+        Controller_BlockCell(controller, cell, length - segment);
+        tail = cell;
+        cell = controller->parent[cell];
+    }
+
+    for (int oldSegment = 0; segment < length; segment++, oldSegment++)
+    {
+        tail = (uint32_t)Snake_GetSegmentCell(snake, oldSegment);
+        Controller_BlockCell(controller, tail, length - segment);
+    }
+
+    return tail;
+}
+
+// ============================================================================
+// SEARCH
+// ============================================================================
+
+/*
+ * A* search over the board against the block map
+ * Open cells sit in one stack per estimated total (moves so far plus the
+ * wrap-around distance to target). The estimate rises by at most two per
+ * move, so three stacks taken round-robin keep the cheapest estimate on
+ * top, and the moves so far are recovered as estimate - distance left.
+ * A cell is requeued whenever a shorter way to it turns up and closed
+ * when it leaves a stack at its fewest moves; entries left behind by a
+ * shorter way are skipped. The distance estimate never drops by more
+ * than one per move, so the first time a cell leaves a stack its move
+ * count is final and the path found is a shortest one. Every stack holds
+ * a single estimate and each cell at most once per estimate, which keeps
+ * it within cellCount entries. On open ground the search runs almost
+ * straight at the target instead of flooding the board, and when the
+ * target cannot be reached it ends having visited every reachable cell.
+ * parent[] links each reached cell to the cell it was reached from.
+ *
+ * @param controller - Controller with search buffers and a block map
+ * @param start - Cell to search from
+ * @param startDistance - Move on which start is entered
+ * @param reverse - Action not taken out of start
+ * @param target - Cell to find
+ * @param acceptVacated - Also stop at any cell a segment has already left
+ *                        (the head can follow the body's trail from there)
+ * @return Where the search stopped
+ */
+static ControllerSearch Controller_Search(Controller* controller, uint32_t start,
+                                          uint32_t startDistance, SimAction reverse,
+                                          uint32_t target, bool acceptVacated)
+{
+    uint32_t* visitStamp = controller->visitStamp;
+    uint32_t* searchDistance = controller->searchDistance;
+    uint32_t generation = Controller_NextGeneration(&controller->visitGeneration, visitStamp,
+                                                    controller->cellCount);
+    uint32_t* buckets[CONTROLLER_BUCKETS];
+    int counts[CONTROLLER_BUCKETS] = { 0 };
+    int reached = 1;
+
+    for (int i = 0; i < CONTROLLER_BUCKETS; i++)
+    {
+        buckets[i] = controller->queue + (size_t)i * controller->cellCount;
+    }
+
+    uint32_t estimate = startDistance + Controller_GetDistance(controller, start, target);
+    visitStamp[start] = generation;
+    searchDistance[start] = startDistance;
+    buckets[estimate % CONTROLLER_BUCKETS][counts[estimate % CONTROLLER_BUCKETS]++] = start;
+
+    // Three empty stacks in a row mean nothing is left open
+    for (int empty = 0; empty < CONTROLLER_BUCKETS; estimate++)
+    {
+        int bucket = (int)(estimate % CONTROLLER_BUCKETS);
+        empty = (counts[bucket] == 0) ? empty + 1 : 0;
+
+        while (counts[bucket] > 0)
+        {
+            uint32_t cell = buckets[bucket][--counts[bucket]];
+            uint32_t distance = estimate - Controller_GetDistance(controller, cell, target);
+
+            // Queued before a shorter way to the cell was found
+            if (distance != searchDistance[cell])
+            {
+                continue;
+            }
+
+            if ((cell == target) ||
+                (acceptVacated && (cell != start) && Controller_IsVacated(controller, cell, distance)))
+            {
+                ControllerSearch found = { cell, distance, reached };
+                return found;
+            }
+
+            uint32_t neighbors[4];
+            Controller_GetNeighbors(controller, cell, neighbors);
+
+            for (int i = 0; i < 4; i++)
+            {
+                uint32_t next = neighbors[i];
+                bool isReverse = (cell == start) && ((SimAction)(i + 1) == reverse);
+                bool isReached = (visitStamp[next] == generation);
+
+                if ((isReached && (searchDistance[next] <= distance + 1)) || isReverse ||
+                    !Controller_IsOpen(controller, next, distance + 1))
+                {
+                    continue;
+                }
+
+                reached += isReached ? 0 : 1;
+                visitStamp[next] = generation;
+                searchDistance[next] = distance + 1;
+                controller->parent[next] = cell;
+
+                uint32_t nextEstimate = distance + 1 + Controller_GetDistance(controller, next, target);
+                int nextBucket = (int)(nextEstimate % CONTROLLER_BUCKETS);
+                buckets[nextBucket][counts[nextBucket]++] = next;
+            }
+        }
+    }
+
+    ControllerSearch notFound = { CONTROLLER_NO_CELL, 0, reached };
+    return notFound;
+}
+
+// ============================================================================
+// GREEDY BOT
+// ============================================================================
+
+/*
+ * Take the free neighboring cell closest to the food, keeping the
+ * current heading on ties. Looks one move ahead only, so a decision
+ * costs the same on any board.
+ */
+static SimAction Controller_DecideGreedy(Controller* controller, const SimState* sim)
+{
+    const Snake* snake = &sim->snake;
+    uint32_t head = snake->body[snake->headIndex];
+    uint32_t tail = (uint32_t)Snake_GetSegmentCell(snake, (int)snake->length - 1);
+    SimAction reverse = Controller_GetReverseAction(snake);
+    uint32_t neighbors[4];
+
+    assert(sim->cellCount == controller->cellCount);
+
+    Controller_GetNeighbors(controller, head, neighbors);
+
+    SimAction forward = reverseAction[reverse];
+    SimAction best = SIM_ACTION_NONE;
+    uint32_t bestDistance = UINT32_MAX;
+    for (int i = 0; i < 4; i++)
+    {
+        SimAction action = (SimAction)(i + 1);
+        uint32_t next = neighbors[i];
+
+        // The tail moves out of the way; every other segment stays
+        if ((action == reverse) ||
+            (Occupancy_IsOccupied(snake->occupancy, (int)next) && (next != tail)))
+        {
+            continue;
+        }
+
+        uint32_t distance = sim->food.active
+            ? Controller_GetDistance(controller, next, sim->food.cell) : 0;
+        if ((distance < bestDistance) || ((distance == bestDistance) && (action == forward)))
+        {
+            best = action;
+            bestDistance = distance;
+        }
+    }
+
+    return best;
+}
+
+// ============================================================================
+// PATH BOT
+// ============================================================================
+
+/*
+ * Pick the move that keeps the snake alive longest when no safe path to
+ * the food exists: a move from which the head can still reach the tail
+ * (the longest way round first), otherwise the move into the largest
+ * open area
+ */
+static SimAction Controller_DecideSurvival(Controller* controller, const Snake* snake)
+{
+    uint32_t head = snake->body[snake->headIndex];
+    uint32_t tail = (uint32_t)Snake_GetSegmentCell(snake, (int)snake->length - 1);
+    SimAction reverse = Controller_GetReverseAction(snake);
+    uint32_t neighbors[4];
+
+    Controller_BlockBody(controller, snake);
+    Controller_GetNeighbors(controller, head, neighbors);
+
+    SimAction best = SIM_ACTION_NONE;
+    long long bestScore = -1;
+    for (int i = 0; i < 4; i++)
+    {
+        SimAction action = (SimAction)(i + 1);
+        uint32_t next = neighbors[i];
+        if ((action == reverse) || !Controller_IsOpen(controller, next, 1))
+        {
+            continue;
+        }
+
+        ControllerSearch search = Controller_Search(controller, next, 1, reverseAction[action],
+                                                    tail, true);
+        long long score = (search.cell != CONTROLLER_NO_CELL)
+            ? controller->cellCount + (long long)search.distance : search.reached;
+
+        if (score > bestScore)
+        {
+            best = action;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Follow the A* path to the food if the snake could still reach its
+ * tail after eating; otherwise play for time. A snake that has played
+ * for time over a whole board's worth of moves may be circling in a
+ * loop the food never leaves, so it takes the path anyway.
+ */
+static SimAction Controller_DecidePath(Controller* controller, const SimState* sim)
+{
+    const Snake* snake = &sim->snake;
+    uint32_t head = snake->body[snake->headIndex];
+
+    assert(sim->cellCount == controller->cellCount);
+
+    if ((snake->length != controller->mealLength) || (sim->tickCount < controller->mealTick))
+    {
+        controller->mealLength = snake->length;
+        controller->mealTick = sim->tickCount;
+    }
+    bool isStalled = (sim->tickCount - controller->mealTick > controller->cellCount);
+
+    if (sim->food.active)
+    {
+        uint32_t food = sim->food.cell;
+
+        Controller_BlockBody(controller, snake);
+        ControllerSearch path = Controller_Search(controller, head, 0,
+                                                  Controller_GetReverseAction(snake), food, false);
+        if (path.cell != CONTROLLER_NO_CELL)
+        {
+            // First step of the path
+            uint32_t step = food;
+            while (controller->parent[step] != head)
+            {
+                step = controller->parent[step];
+            }
+
+            if (isStalled)
+            {
+                return Controller_GetActionTowards(controller, snake, step);
+            }
+
+            // Move that enters the food, then the way out for the grown snake
+            uint32_t beforeFood = controller->parent[food];
+            uint32_t neighbors[4];
+            SimAction arrival = SIM_ACTION_NONE;
+            Controller_GetNeighbors(controller, beforeFood, neighbors);
+            for (int i = 3; i >= 0; i--)
+            {
+                if (neighbors[i] == food)
+                {
+                    arrival = (SimAction)(i + 1);
+                }
+            }
+
+            uint32_t tail = Controller_BlockBodyAfterPath(controller, snake, food, path.distance);
+            ControllerSearch escape = Controller_Search(controller, food, 0, reverseAction[arrival],
+                                                        tail, true);
+            if (escape.cell != CONTROLLER_NO_CELL)
+            {
+                return Controller_GetActionTowards(controller, snake, step);
+            }
+        }
+    }
+
+    return Controller_DecideSurvival(controller, snake);
+}
+
+// ============================================================================
+// CYCLE BOT
+// ============================================================================
+
+/*
+ * Lay a Hamiltonian cycle over the board
+ * Row 0 left to right, the other rows back and forth over columns 1 and
+ * up, then column 0 back up to the start. The step from the last row
+ * into column 0 wraps around when the row count is odd, so every board
+ * size has a cycle. The game's start (cell 0 heading right) is on it.
+ *
+ * @param controller - Controller with cycle buffers
+ */
+static void Controller_BuildCycle(Controller* controller)
+{
+    int columns = controller->columns;
+    int rows = controller->rows;
+    uint32_t index = 0;
+    uint32_t previous = 0;
+
+    for (int row = 0; row < rows; row++)
+    {
+        for (int step = (row == 0) ? 0 : 1; step < columns; step++)
+        {
+            int column = (row % 2 == 1) ? columns - step : step;
+            uint32_t cell = (uint32_t)(row * columns + column);
+            controller->cycleIndex[cell] = index++;
+            controller->cycleNext[previous] = cell;
+            previous = cell;
+        }
+    }
+
+    for (int row = rows - 1; row > 0; row--)
+    {
+        uint32_t cell = (uint32_t)(row * columns);
+        controller->cycleIndex[cell] = index++;
+        controller->cycleNext[previous] = cell;
+        previous = cell;
+    }
+
+    controller->cycleNext[previous] = 0;
+}
+
+/*
+ * Cells from one cycle position forward to another
+ */
+static uint32_t Controller_GetCycleGap(const Controller* controller, uint32_t from, uint32_t to)
+{
+    return (to >= from) ? to - from : to + (uint32_t)controller->cellCount - from;
+}
+
+/*
+ * Follow the cycle, jumping ahead to a neighboring cell further along it
+ * while the snake covers less than CYCLE_SHORTCUT_MAX_FILL percent of
+ * the board. A jump never passes the food and stays short of the tail,
+ * so the body keeps the cycle's order and the head can never run into it.
+ */
+static SimAction Controller_DecideCycle(Controller* controller, const SimState* sim)
+{
+    const Snake* snake = &sim->snake;
+    uint32_t head = snake->body[snake->headIndex];
+    uint32_t next = controller->cycleNext[head];
+
+    assert(sim->cellCount == controller->cellCount);
+
+    if (sim->food.active &&
+        ((long long)snake->length * 100 < (long long)controller->cellCount * CYCLE_SHORTCUT_MAX_FILL))
+    {
+        uint32_t headIndex = controller->cycleIndex[head];
+        uint32_t tail = (uint32_t)Snake_GetSegmentCell(snake, (int)snake->length - 1);
+        uint32_t foodGap = Controller_GetCycleGap(controller, headIndex,
+                                                  controller->cycleIndex[sim->food.cell]);
+        uint32_t tailGap = (snake->length > 1)
+            ? Controller_GetCycleGap(controller, headIndex, controller->cycleIndex[tail])
+            : (uint32_t)controller->cellCount;
+        SimAction reverse = Controller_GetReverseAction(snake);
+        uint32_t neighbors[4];
+        uint32_t bestJump = 1;
+
+        Controller_GetNeighbors(controller, head, neighbors);
+        for (int i = 0; i < 4; i++)
+        {
+            uint32_t jump = Controller_GetCycleGap(controller, headIndex,
+                                                   controller->cycleIndex[neighbors[i]]);
+            if (((SimAction)(i + 1) != reverse) && (jump > bestJump) && (jump <= foodGap) &&
+                (jump + CYCLE_SHORTCUT_MARGIN < tailGap))
+            {
+                next = neighbors[i];
+                bestJump = jump;
+            }
+        }
+    }
+
+    return Controller_GetActionTowards(controller, snake, next);
+}
+
+// ============================================================================
+// CREATION
+// ============================================================================
+
+/*
+ * Take one uint32_t per board cell from an arena
+ */
+static uint32_t* Controller_AllocateCells(Arena* arena, int cellCount)
+{
+    return Arena_Allocate(arena, (size_t)cellCount * sizeof(uint32_t), sizeof(uint32_t));
+}
+
+/*
+ * Set up a controller that calls decide for every move
+ *
+ * @param controller - Controller to initialize
+ * @param decide - Function returning the action for a move
+ * @param context - Passed through untouched for decide's own use
+ */
+void Controller_Initialize(Controller* controller, ControllerDecideFunc decide, void* context)
+{
+    assert(controller != NULL);
+    assert(decide != NULL);
+
+    memset(controller, 0, sizeof(*controller));
+    controller->decide = decide;
+    controller->context = context;
+}
+
+/*
+ * Set up a built-in bot for the current board size
+ * Search buffers come from the arena, so a decision never allocates
+ *
+ * @param controller - Controller to initialize
+ * @param bot - Bot to play with
+ * @param arena - Arena the bot's buffers are taken from
+ * @return true on success, false if memory could not be allocated
+ */
+bool Controller_CreateBot(Controller* controller, ControllerBot bot, Arena* arena)
+{
+    assert(controller != NULL);
+    assert(arena != NULL);
+    assert(bot >= 0 && bot < CONTROLLER_BOT_COUNT);
+
+    static const ControllerDecideFunc decideFuncs[CONTROLLER_BOT_COUNT] = {
+        Controller_DecideGreedy,
+        Controller_DecidePath,
+        Controller_DecideCycle
+    };
+
+    Controller_Initialize(controller, decideFuncs[bot], NULL);
+    controller->columns = Utils_GetGridColumns();
+    controller->rows = Utils_GetGridRows();
+    controller->cellCount = Utils_GetCellCount();
+
+    int cellCount = controller->cellCount;
+    if (bot == CONTROLLER_BOT_PATH)
+    {
+        controller->queue = Arena_Allocate(arena, (size_t)cellCount * CONTROLLER_BUCKETS * sizeof(uint32_t),
+                                           sizeof(uint32_t));
+        controller->parent = Controller_AllocateCells(arena, cellCount);
+        controller->searchDistance = Controller_AllocateCells(arena, cellCount);
+        controller->visitStamp = Controller_AllocateCells(arena, cellCount);
+        controller->blockStamp = Controller_AllocateCells(arena, cellCount);
+        controller->blockedUntil = Controller_AllocateCells(arena, cellCount);
+        if (!controller->queue || !controller->parent || !controller->searchDistance ||
+            !controller->visitStamp || !controller->blockStamp || !controller->blockedUntil)
+        {
+            return false;
+        }
+
+        memset(controller->visitStamp, 0, (size_t)cellCount * sizeof(uint32_t));
+        memset(controller->blockStamp, 0, (size_t)cellCount * sizeof(uint32_t));
+    }
+    else if (bot == CONTROLLER_BOT_CYCLE)
+    {
+        controller->cycleNext = Controller_AllocateCells(arena, cellCount);
+        controller->cycleIndex = Controller_AllocateCells(arena, cellCount);
+        if (!controller->cycleNext || !controller->cycleIndex)
+        {
+            return false;
+        }
+
+        Controller_BuildCycle(controller);
+    }
+
+    return true;
+}
+
+// ============================================================================
+// DECISIONS
+// ============================================================================
+
+/*
+ * Ask a controller for the action of the next move
+ *
+ * @param controller - Controller to ask
+ * @param sim - Game about to be stepped
+ * @return Action to pass to Sim_Step
+ */
+SimAction Controller_Decide(Controller* controller, const SimState* sim)
+{
+    assert(controller != NULL);
+    assert(controller->decide != NULL);
+    assert(sim != NULL);
+
+    return controller->decide(controller, sim);
+}
+
+/*
+ * Get the command-line name of a bot
+ *
+ * @param bot - Bot
+ * @return Name such as "path"
+ */
+const char* Controller_GetBotName(ControllerBot bot)
+{
+    assert(bot >= 0 && bot < CONTROLLER_BOT_COUNT);
+
+    return botNames[bot];
+}
@@ -8,7 +8,7 @@
  * Date: February 2026
  */
 
-#include "snake_game.h"
+#include "snake_sim.h"
 
 
 // ==============================
@@ -17,21 +17,14 @@
 
 /*
  * initialize food
- * set size and color
  * food is not active at start
  */
 void Food_Initialize(Food* f)
 {
 
-    f->size.x = SQUARE_SIZE;
-    f->size.y = SQUARE_SIZE;
-
-    f->color = YELLOW;
-
     f->active = false;
 
-    f->position.x = 0;
-    f->position.y = 0;
+    f->cell = 0;
 
 }
 
@@ -44,56 +37,26 @@ void Food_Initialize(Food* f)
 /*
  * generate food at random place
  * avoid snake body
+ * one random draw from the free-cell index, so cost
+ * does not grow as the snake fills the board
+ * the draw comes from the game's own rng
  */
-void Food_Spawn(Food* f, Snake* s, Vector2 off)
+void Food_Spawn(Food* f, const FreeCellSet* freeCells, Rng* rng)
 {
 
-    int c = Utils_GetGridColumns();
-    int r = Utils_GetGridRows();
-
-    int fx, fy;
-
-    f->active = true;
-
-
     // if snake fills grid then no food
-    if(s->length >= c*r)
+    if(freeCells->count == 0)
     {
         f->active = false;
         return;
     }
 
 
-    int ok = 0;
+    int slot = (int)Rng_NextBounded(rng,(uint32_t)freeCells->count);
 
+    f->cell = freeCells->cells[slot];
 
-    // find empty place
-    while(!ok)
-    {
-
-        ok = 1;
-
-        fx = GetRandomValue(0,c-1);
-        fy = GetRandomValue(0,r-1);
-
-        f->position.x = off.x + fx*SQUARE_SIZE;
-        f->position.y = off.y + fy*SQUARE_SIZE;
-
-
-        // check collision with snake
-        for(int i=0;i<s->length;i++)
-        {
-
-            if(f->position.x == s->segments[i].position.x &&
-               f->position.y == s->segments[i].position.y)
-            {
-                ok = 0;
-                break;
-            }
-
-        }
-
-    }
+    f->active = true;
 
 }
 
@@ -106,43 +69,17 @@ void Food_Spawn(Food* f, Snake* s, Vector2 off)
 /*
  * check snake head hit food
  */
-bool Food_CheckCollision(Food* f, Vector2 p)
+bool Food_CheckCollision(const Food* f, int cell)
 {
 
     if(f->active == false)
         return false;
 
 
-    if(f->position.x == p.x &&
-       f->position.y == p.y)
+    if((int)f->cell == cell)
         return true;
 
 
     return false;
 
 }
-
-
-
-// ==============================
-// DRAW FOOD
-// ==============================
-
-/*
- * draw food on screen
- */
-void Food_Render(Food* f)
-{
-
-    if(f->active)
-    {
-
-        DrawRectangleV(
-            f->position,
-            f->size,
-            f->color
-        );
-
-    }
-
-}
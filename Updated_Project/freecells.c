@@ -0,0 +1,144 @@
+/*
+ * freecells.c
+ *
+ * Free-cell index module
+ * Keeps a dense list of every grid cell not covered by the snake, plus the
+ * slot of each cell inside that list, so cells can be added, removed and
+ * sampled in constant time regardless of how full the board is
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+
+// ============================================================================
+// SET INITIALIZATION
+// ============================================================================
+
+/*
+ * Mark every cell of the grid as free
+ *
+ * @param set - Pointer to free-cell set to initialize
+ * @param cellCount - Number of cells on the grid (both arrays must hold
+ *                    that many entries)
+ */
+void FreeCells_Initialize(FreeCellSet* set, int cellCount)
+{
+    assert(set != NULL);
+    assert(cellCount >= 0);
+    assert(set->cells != NULL && set->slotOf != NULL);
+
+    for (int i = 0; i < cellCount; i++)
+    {
+        set->cells[i] = (uint32_t)i;
+        set->slotOf[i] = (uint32_t)i;
+    }
+
+    set->count = cellCount;
+}
+
+// ============================================================================
+// MEMBERSHIP
+// ============================================================================
+
+/*
+ * Check whether a cell is currently free
+ *
+ * @param set - Pointer to free-cell set
+ * @param cell - Cell index to look up
+ * @return true if the cell is in the set
+ */
+bool FreeCells_Contains(const FreeCellSet* set, int cell)
+{
+    assert(set != NULL);
+    assert(cell >= 0);
+
+    int slot = (int)set->slotOf[cell];
+    return (slot < set->count) && ((int)set->cells[slot] == cell);
+}
+
+/*
+ * Add a cell to the set (no effect if it is already free)
+ *
+ * @param set - Pointer to free-cell set
+ * @param cell - Cell that has been vacated
+ */
+void FreeCells_Add(FreeCellSet* set, int cell)
+{
+    assert(set != NULL);
+
+    if (FreeCells_Contains(set, cell))
+    {
+        return;
+    }
+
+    set->cells[set->count] = (uint32_t)cell;
+    set->slotOf[cell] = (uint32_t)set->count;
+    set->count++;
+}
+
+/*
+ * Remove a cell from the set (no effect if it is not free)
+ * The last entry is swapped into the vacated slot to keep the list dense
+ *
+ * @param set - Pointer to free-cell set
+ * @param cell - Cell that has been occupied
+ */
+void FreeCells_Remove(FreeCellSet* set, int cell)
+{
+    assert(set != NULL);
+
+    if (!FreeCells_Contains(set, cell))
+    {
+        return;
+    }
+
+    int slot = (int)set->slotOf[cell];
+    uint32_t last = set->cells[set->count - 1];
+
+    set->cells[slot] = last;
+    set->slotOf[last] = (uint32_t)slot;
+    set->count--;
+}
+
+// ============================================================================
+// UNDO
+// ============================================================================
+
+/*
+ * Take back the most recent FreeCells_Add that changed the set
+ *
+ * @param set - Pointer to free-cell set
+ */
+void FreeCells_UndoAdd(FreeCellSet* set)
+{
+    assert(set != NULL);
+    assert(set->count > 0);
+
+    set->count--;
+}
+
+/*
+ * Take back the most recent FreeCells_Remove that changed the set
+ * Moves the entry swapped into the slot back to the end, so the list
+ * order is exactly what it was before the removal
+ *
+ * @param set - Pointer to free-cell set
+ * @param cell - Cell that was removed
+ * @param slot - Slot the cell held when it was removed
+ */
+void FreeCells_UndoRemove(FreeCellSet* set, int cell, int slot)
+{
+    assert(set != NULL);
+    assert(slot >= 0 && slot <= set->count);
+
+    uint32_t moved = set->cells[slot];
+
+    set->cells[set->count] = moved;
+    set->slotOf[moved] = (uint32_t)set->count;
+    set->cells[slot] = (uint32_t)cell;
+    set->slotOf[cell] = (uint32_t)slot;
+    set->count++;
+}
@@ -16,32 +16,364 @@
 // ============================================================================
 
 static GameState gameState = { 0 };
-static Snake playerSnake = { 0 };
-static Food gameFruit = { 0 };
+
+static SimAction Game_DecideKeyboard(Controller* controller, const SimState* sim);
 
 // ============================================================================
 // GAME INITIALIZATION
 // ============================================================================
 
+/*
+ * Carve the simulation (or the match) for the current board out of the
+ * game arena. Everything allocated after it belongs to the round.
+ * 
+ * @return true on success, false if the board could not be allocated
+ */
+static bool Game_CreateSimulation(void)
+{
+    if (gameState.isMatch)
+    {
+        gameState.matchActions = Arena_Allocate(&gameState.arena,
+                                                (size_t)gameState.matchSnakeCount * sizeof(SimAction),
+                                                sizeof(SimAction));
+        if ((gameState.matchActions == NULL) ||
+            !Match_Create(&gameState.match, &gameState.arena,
+                          gameState.matchSnakeCount, gameState.matchSnakeCount))
+        {
+            gameState.match.cellCount = 0;
+            return false;
+        }
+    }
+    else
+    {
+        if (!Sim_Create(&gameState.sim, &gameState.arena) ||
+            !Path_Create(&gameState.pathHint, &gameState.arena))
+        {
+            gameState.sim.cellCount = 0;
+            return false;
+        }
+
+        if (gameState.hasMcts)
+        {
+            if (!Mcts_Create(&gameState.mcts, &gameState.arena,
+                             gameState.mctsBudgetMicroseconds, gameState.mctsPool))
+            {
+                gameState.sim.cellCount = 0;
+                return false;
+            }
+            Mcts_AttachController(&gameState.controller, &gameState.mcts);
+        }
+        else if (!gameState.hasBot)
+        {
+            Controller_Initialize(&gameState.controller, Game_DecideKeyboard, NULL);
+        }
+        else if (!Controller_CreateBot(&gameState.controller, gameState.bot, &gameState.arena))
+        {
+            gameState.sim.cellCount = 0;
+            return false;
+        }
+    }
+
+    gameState.roundMark = Arena_GetMark(&gameState.arena);
+    return true;
+}
+
+/*
+ * Cells of the board the arena was carved for, 0 before the first round
+ */
+static int Game_GetCreatedCellCount(void)
+{
+    return gameState.isMatch ? gameState.match.cellCount : gameState.sim.cellCount;
+}
+
 /*
  * Initialize all game systems and reset game state
- * Called at game start and when restarting after game over
+ * Called at game start and when restarting after game over. A restart
+ * on the same board drops the last round's memory in O(1) and reuses
+ * the simulation; only a new board size rebuilds the arena.
+ * 
+ * @param seed - Seed for the round; the same seed and the same inputs
+ *               reproduce the round exactly
+ * @return true on success, false if the board could not be allocated
  */
-void Game_Initialize(void)
+bool Game_Initialize(uint64_t seed)
 {
+    if (Game_GetCreatedCellCount() != Utils_GetCellCount())
+    {
+        Arena_Reset(&gameState.arena);
+        if (!Game_CreateSimulation())
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Arena_ResetToMark(&gameState.arena, gameState.roundMark);
+    }
+
     // Reset game state
-    gameState.framesCounter = 0;
-    gameState.playerScore = 0;
+    InputQueue_Clear(&gameState.input);
+    for (int player = 0; player < MATCH_MAX_PLAYERS; player++)
+    {
+        InputQueue_Clear(&gameState.playerInput[player]);
+    }
+    gameState.isTurnPending = false;
+    gameState.inputLatencyMax = 0.0;
     gameState.isGameOver = false;
     gameState.isPaused = false;
     gameState.freezeCounter = 0;
+    gameState.movedOnLastTick = false;
+    gameState.grewOnLastTick = false;
+    gameState.playbackBudget = 0.0f;
     
-    // Calculate grid offset for centering
+    // Calculate grid offset for centering and cache the static grid
     gameState.gridOffset = Utils_CalculateGridOffset();
-    
-    // Initialize game entities
-    Snake_Initialize(&playerSnake, gameState.gridOffset, gameState.gridOffset);
-    Food_Initialize(&gameFruit);
+    Renderer_Initialize(gameState.gridOffset);
+    Renderer_InvalidateBoard();
+
+    // A replay restarts from its own seed; otherwise record the new round
+    // (a match is not recorded)
+    if (gameState.isMatch)
+    {
+        gameState.seed = seed;
+        Match_Initialize(&gameState.match, seed);
+        return true;
+    }
+    else if (gameState.isPlayback)
+    {
+        seed = gameState.replay.seed;
+        Replay_BeginPlayback(&gameState.playback, &gameState.replay);
+    }
+    else
+    {
+        Replay_Initialize(&gameState.replay, &gameState.arena);
+        Replay_Begin(&gameState.replay, seed);
+    }
+
+    gameState.seed = seed;
+    Sim_Initialize(&gameState.sim, seed);
+
+    return true;
+}
+
+/*
+ * Play a multi-snake match instead of the single-snake game
+ * Must be called before Game_Initialize
+ * 
+ * @param snakeCount - Snakes on the board, 1 to MATCH_MAX_SNAKES
+ * @param playerCount - How many of them are local players, 0 to
+ *                      MATCH_MAX_PLAYERS; the rest are bots
+ */
+void Game_SetMatchMode(int snakeCount, int playerCount)
+{
+    assert(snakeCount > 0 && snakeCount <= MATCH_MAX_SNAKES);
+    assert(playerCount >= 0 && playerCount <= MATCH_MAX_PLAYERS && playerCount <= snakeCount);
+
+    gameState.isMatch = true;
+    gameState.matchSnakeCount = snakeCount;
+    gameState.matchPlayerCount = playerCount;
+}
+
+/*
+ * Let a built-in bot play the single-snake game instead of the keyboard
+ * Must be called before Game_Initialize
+ * 
+ * @param bot - Bot to play
+ */
+void Game_SetBot(ControllerBot bot)
+{
+    assert(bot >= 0 && bot < CONTROLLER_BOT_COUNT);
+
+    gameState.hasBot = true;
+    gameState.bot = bot;
+}
+
+/*
+ * Let the tree search player play the single-snake game
+ * Must be called before Game_Initialize
+ * 
+ * @param budgetMicroseconds - Search time per move
+ * @param pool - Pool to search on with one tree per worker, or NULL for
+ *               a single tree; must outlive the game
+ */
+void Game_SetMcts(int budgetMicroseconds, ThreadPool* pool)
+{
+    assert(budgetMicroseconds > 0);
+
+    gameState.hasBot = true;
+    gameState.hasMcts = true;
+    gameState.mctsBudgetMicroseconds = budgetMicroseconds;
+    gameState.mctsPool = pool;
+}
+
+// ============================================================================
+// REPLAY RECORDING AND PLAYBACK
+// ============================================================================
+
+/*
+ * Save every finished round to a replay file (the last round wins)
+ * 
+ * @param path - File to write, or NULL to stop saving
+ */
+void Game_SetRecordPath(const char* path)
+{
+    gameState.recordPath = path;
+}
+
+/*
+ * Load a replay and play it back instead of reading the keyboard
+ * Switches the board to the size the replay was recorded on. The replay
+ * goes to the bottom of the arena, below the simulation, so restarts
+ * keep it.
+ * 
+ * @param path - Replay file to load
+ * @param rate - Moves per normal move interval (2.0 = double speed)
+ * @return true if the replay was loaded, false otherwise
+ */
+bool Game_StartPlayback(const char* path, float rate)
+{
+    assert(path != NULL);
+    assert(rate > 0.0f);
+
+    Arena_Reset(&gameState.arena);
+    gameState.sim.cellCount = 0;
+    Replay_Initialize(&gameState.replay, &gameState.arena);
+    if (!Replay_Load(&gameState.replay, path))
+    {
+        return false;
+    }
+
+    gameState.isPlayback = true;
+    gameState.playbackRate = rate;
+    Utils_SetBoardSize(gameState.replay.columns, gameState.replay.rows);
+
+    return Game_CreateSimulation() && Game_Initialize(gameState.replay.seed);
+}
+
+/*
+ * Close the current recording and write it out if a path is set
+ */
+static void Game_FinishRecording(void)
+{
+    if (gameState.isMatch || gameState.isPlayback || gameState.replay.isFinished)
+    {
+        return;
+    }
+
+    if (Replay_Finish(&gameState.replay, gameState.sim.tickCount) &&
+        (gameState.recordPath != NULL))
+    {
+        Replay_Save(&gameState.replay, gameState.recordPath);
+    }
+}
+
+// ============================================================================
+// INPUT PROCESSING
+// ============================================================================
+
+/*
+ * Queue every arrow key pressed since the last frame, in press order
+ * Turns that are not legal after the already queued ones are dropped
+ */
+static void Game_ReadInput(void)
+{
+    int key;
+
+    while ((key = GetKeyPressed()) != 0)
+    {
+        SimAction action = SIM_ACTION_NONE;
+
+        switch (key)
+        {
+            case KEY_RIGHT: action = SIM_ACTION_RIGHT; break;
+            case KEY_LEFT:  action = SIM_ACTION_LEFT;  break;
+            case KEY_UP:    action = SIM_ACTION_UP;    break;
+            case KEY_DOWN:  action = SIM_ACTION_DOWN;  break;
+            default: break;
+        }
+
+        InputQueue_Push(&gameState.input, gameState.sim.snake.directionX != 0, action, GetTime());
+    }
+}
+
+/*
+ * Queue match turns: arrow keys steer player 1 and WASD player 2
+ */
+static void Game_ReadMatchInput(void)
+{
+    int key;
+
+    while ((key = GetKeyPressed()) != 0)
+    {
+        SimAction action = SIM_ACTION_NONE;
+        int player = 0;
+
+        switch (key)
+        {
+            case KEY_RIGHT: action = SIM_ACTION_RIGHT; break;
+            case KEY_LEFT:  action = SIM_ACTION_LEFT;  break;
+            case KEY_UP:    action = SIM_ACTION_UP;    break;
+            case KEY_DOWN:  action = SIM_ACTION_DOWN;  break;
+            case KEY_D:     action = SIM_ACTION_RIGHT; player = 1; break;
+            case KEY_A:     action = SIM_ACTION_LEFT;  player = 1; break;
+            case KEY_W:     action = SIM_ACTION_UP;    player = 1; break;
+            case KEY_S:     action = SIM_ACTION_DOWN;  player = 1; break;
+            default: break;
+        }
+
+        const MatchSnake* snake = &gameState.match.snakes[player];
+        if ((player < gameState.matchPlayerCount) && snake->isAlive)
+        {
+            InputQueue_Push(&gameState.playerInput[player], snake->directionX != 0,
+                            action, GetTime());
+        }
+    }
+}
+
+/*
+ * Record the latency of the turn that has just become visible
+ * 
+ * @param now - Time the frame showing the turn was presented
+ */
+static void Game_RecordInputLatency(double now)
+{
+    double latency = (now - gameState.turnPressTime) * 1000.0;
+
+    gameState.inputLatencyMilliseconds = latency;
+    gameState.inputLatencyAverage = (gameState.inputLatencyAverage > 0.0)
+        ? gameState.inputLatencyAverage + 0.1 * (latency - gameState.inputLatencyAverage)
+        : latency;
+    if (latency > gameState.inputLatencyMax)
+    {
+        gameState.inputLatencyMax = latency;
+    }
+
+    gameState.isTurnPending = false;
+}
+
+/*
+ * Keyboard controller: one queued turn per move; its latency is
+ * measured once drawn
+ * 
+ * @param controller - Unused
+ * @param sim - Unused
+ * @return Next queued turn, or SIM_ACTION_NONE
+ */
+static SimAction Game_DecideKeyboard(Controller* controller, const SimState* sim)
+{
+    (void)controller;
+    (void)sim;
+
+    double pressTime = 0.0;
+    SimAction action = InputQueue_Pop(&gameState.input, &pressTime);
+
+    if (action != SIM_ACTION_NONE)
+    {
+        gameState.turnPressTime = pressTime;
+        gameState.isTurnPending = true;
+    }
+
+    return action;
 }
 
 // ============================================================================
@@ -49,95 +381,309 @@ void Game_Initialize(void)
 // ============================================================================
 
 /*
- * Main game update function
- * Called once per frame to update game state
+ * Advance the simulation by one move and react to its events
+ * 
+ * @param action - Action for this move
  */
-void Game_Update(void)
+static void Game_StepSimulation(SimAction action)
 {
-    if (!gameState.isGameOver)
+    if (!gameState.isPlayback && !gameState.replay.isFinished)
     {
-        // Handle pause toggle
-        if (IsKeyPressed('P'))
+        Replay_RecordAction(&gameState.replay, gameState.sim.tickCount,
+                            &gameState.sim.snake, action);
+    }
+
+    int events = Sim_Step(&gameState.sim, action);
+    gameState.movedOnLastTick = true;
+    gameState.grewOnLastTick = (events & SIM_EVENT_ATE) != 0;
+
+    // Follow every move while the hint is shown, so each costs a repair
+    if (gameState.showPathHint)
+    {
+        Path_Update(&gameState.pathHint, &gameState.sim);
+    }
+
+    if (events & SIM_EVENT_DIED)
+    {
+        gameState.freezeCounter = FREEZE_DURATION;
+        Game_FinishRecording();
+    }
+}
+
+/*
+ * Run as many recorded moves as the playback rate allows this tick
+ * A replay that ends without a death (the player quit) goes straight
+ * to the game over screen
+ */
+static void Game_AdvancePlayback(void)
+{
+    gameState.playbackBudget += gameState.playbackRate;
+
+    while ((gameState.playbackBudget >= 1.0f) && (gameState.freezeCounter == 0))
+    {
+        if (gameState.sim.tickCount >= gameState.replay.tickCount)
         {
-            gameState.isPaused = !gameState.isPaused;
+            gameState.isGameOver = true;
+            return;
         }
 
-        if (!gameState.isPaused)
+        SimAction action = Replay_NextAction(&gameState.playback, gameState.sim.tickCount,
+                                             &gameState.sim.snake);
+        Game_StepSimulation(action);
+        gameState.playbackBudget -= 1.0f;
+    }
+}
+
+/*
+ * Advance a match by one move: players take one queued turn each and
+ * bots choose their own. A dead player's pending turns are dropped.
+ */
+static void Game_StepMatch(void)
+{
+    MatchState* match = &gameState.match;
+
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        if (i >= gameState.matchPlayerCount)
         {
-            // Handle freeze countdown (delay before game over)
-            if (gameState.freezeCounter > 0)
-            {
-                gameState.freezeCounter--;
-                if (gameState.freezeCounter == 0)
-                {
-                    gameState.isGameOver = true;
-                }
-                return;  // Skip game logic during freeze
-            }
+            gameState.matchActions[i] = Match_ChooseBotAction(match, i);
+        }
+        else if (match->snakes[i].isAlive)
+        {
+            gameState.matchActions[i] = InputQueue_Pop(&gameState.playerInput[i], NULL);
+        }
+        else
+        {
+            InputQueue_Clear(&gameState.playerInput[i]);
+            gameState.matchActions[i] = SIM_ACTION_NONE;
+        }
+    }
 
-            // Process player input
-            Snake_ProcessInput(&playerSnake);
+    Match_Step(match, gameState.matchActions);
+}
 
-            // Update snake position
-            Snake_UpdatePosition(&playerSnake, gameState.framesCounter);
+/*
+ * Per-frame input handling
+ * Called once per rendered frame: toggles, pause, restart and latching
+ * the player's next turn. Movement happens in Game_Tick.
+ */
+void Game_Update(void)
+{
+    // Frame timing overlay toggle
+    if (IsKeyPressed('F'))
+    {
+        gameState.showFrameTime = !gameState.showFrameTime;
+    }
 
-            // Handle screen wrap-around
-            Snake_HandleWrapAround(&playerSnake, gameState.gridOffset);
+    // Profiler overlay toggle
+    if (IsKeyPressed('O'))
+    {
+        gameState.showProfiler = !gameState.showProfiler;
+    }
 
-            // Check for self-collision
-            if (Snake_CheckSelfCollision(&playerSnake))
-            {
-                gameState.freezeCounter = FREEZE_DURATION;
-            }
+    // Path hint toggle
+    if (IsKeyPressed('H'))
+    {
+        gameState.showPathHint = !gameState.showPathHint;
+    }
 
-            // Spawn food if not active
-            if (!gameFruit.active)
+    // Incremental / full redraw toggle
+    if (IsKeyPressed('I'))
+    {
+        gameState.useFullRedraw = !gameState.useFullRedraw;
+        Renderer_InvalidateBoard();
+    }
+
+    if (!gameState.isGameOver)
+    {
+        // Handle pause toggle
+        if (IsKeyPressed('P'))
+        {
+            gameState.isPaused = !gameState.isPaused;
+        }
+
+        // Queue turns for the next moves
+        if (!gameState.isPaused && !gameState.isPlayback)
+        {
+            uint64_t inputStart = Profiler_Begin();
+            if (gameState.isMatch)
             {
-                Food_Spawn(&gameFruit, &playerSnake, gameState.gridOffset);
+                Game_ReadMatchInput();
             }
-
-            // Check collision with food
-            if (Collision_CheckSnakeWithFood(&playerSnake, &gameFruit))
+            else if (!gameState.hasBot)
             {
-                Snake_Grow(&playerSnake);
-                gameFruit.active = false;
-                gameState.playerScore++;
+                Game_ReadInput();
             }
-
-            gameState.framesCounter++;
+            Profiler_End(PROFILE_INPUT, inputStart);
         }
     }
     else
     {
-        // Game over - wait for restart
+        // Game over - wait for restart; each round uses the next seed so a
+        // whole session is reproducible from the starting seed (a replay
+        // simply starts over)
         if (IsKeyPressed(KEY_ENTER))
         {
-            Game_Initialize();
+            Game_Initialize(gameState.seed + 1);
         }
     }
 }
 
+/*
+ * Fixed-timestep game logic
+ * Called TICK_RATE times per second of play regardless of frame rate;
+ * each call is one snake move
+ */
+void Game_Tick(void)
+{
+    gameState.movedOnLastTick = false;
+
+    if (gameState.isGameOver || gameState.isPaused)
+    {
+        return;
+    }
+
+    // Handle freeze countdown (delay before game over)
+    if (gameState.freezeCounter > 0)
+    {
+        gameState.freezeCounter--;
+        if (gameState.freezeCounter == 0)
+        {
+            gameState.isGameOver = true;
+        }
+        return;  // Skip game logic during freeze
+    }
+
+    uint64_t tickStart = Profiler_Begin();
+
+    if (gameState.isMatch)
+    {
+        Game_StepMatch();
+    }
+    else if (gameState.isPlayback)
+    {
+        Game_AdvancePlayback();
+    }
+    else
+    {
+        Game_StepSimulation(Controller_Decide(&gameState.controller, &gameState.sim));
+    }
+
+    Profiler_End(PROFILE_TICK, tickStart);
+}
+
 // ============================================================================
 // GAME RENDERING
 // ============================================================================
 
+/*
+ * Draw a match: every snake on its cells plus the scoreboard
+ * Snakes are drawn from the ownership chains each frame, so the cost
+ * follows the total snake length rather than the board size
+ */
+static void Game_RenderMatch(void)
+{
+    Renderer_Initialize(gameState.gridOffset);
+
+    double drawStart = GetTime();
+    uint64_t phaseStart = Profiler_Begin();
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+
+    Renderer_DrawGrid(gameState.gridOffset);
+    phaseStart = Profiler_End(PROFILE_RENDER_BOARD, phaseStart);
+    Renderer_DrawMatch(&gameState.match, gameState.gridOffset, gameState.matchPlayerCount);
+    phaseStart = Profiler_End(PROFILE_RENDER_SNAKE, phaseStart);
+
+    double drawMilliseconds = (GetTime() - drawStart) * 1000.0;
+    gameState.drawMilliseconds += 0.1 * (drawMilliseconds - gameState.drawMilliseconds);
+
+    Renderer_DrawMatchScores(&gameState.match, gameState.matchPlayerCount);
+    if (gameState.isPaused)
+    {
+        Renderer_DrawPauseScreen();
+    }
+
+    if (gameState.showFrameTime)
+    {
+        Renderer_DrawFrameTime(GetFrameTime() * 1000.0f, gameState.drawMilliseconds);
+    }
+
+    if (gameState.showProfiler)
+    {
+        Renderer_DrawProfiler();
+    }
+    phaseStart = Profiler_End(PROFILE_RENDER_OVERLAY, phaseStart);
+
+    EndDrawing();
+    Profiler_End(PROFILE_RENDER_PRESENT, phaseStart);
+}
+
 /*
  * Main rendering function
- * Draws all game elements to screen
+ * Draws all game elements to screen, with the snake's head and tail
+ * interpolated between the last two moves
+ * 
+ * @param alpha - Fraction of the current tick that has elapsed, 0 to 1
  */
-void Game_Render(void)
+void Game_Render(float alpha)
 {
+    if (gameState.isMatch)
+    {
+        Game_RenderMatch();
+        return;
+    }
+
+    const Snake* snake = &gameState.sim.snake;
+    const Food* food = &gameState.sim.food;
+
+    // Only a snake that moved on the last tick is between two cells
+    bool isMoving = gameState.movedOnLastTick && !gameState.isPaused;
+    float motion = isMoving ? alpha : 1.0f;
+    bool tailMoved = !gameState.grewOnLastTick;
+
+    // Rebuild the cached grid if the window was resized
+    Renderer_Initialize(gameState.gridOffset);
+
+    // Patch the persistent board with the cells changed since the last move
+    double drawStart = GetTime();
+    uint64_t phaseStart = Profiler_Begin();
+    if (!gameState.isGameOver && !gameState.useFullRedraw)
+    {
+        Renderer_UpdateBoard(snake, food, gameState.gridOffset);
+    }
+
     BeginDrawing();
     ClearBackground(BLACK);
 
     if (!gameState.isGameOver)
     {
-        // Draw game grid
-        Renderer_DrawGrid(gameState.gridOffset);
+        if (gameState.useFullRedraw)
+        {
+            Renderer_DrawGrid(gameState.gridOffset);
+            Food_Render(food, gameState.gridOffset);
+            phaseStart = Profiler_End(PROFILE_RENDER_BOARD, phaseStart);
+            Snake_Render(snake, gameState.gridOffset, motion, tailMoved);
+        }
+        else
+        {
+            Renderer_DrawBoard(snake, food, gameState.gridOffset);
+            phaseStart = Profiler_End(PROFILE_RENDER_BOARD, phaseStart);
+            Snake_RenderMotion(snake, gameState.gridOffset, motion, tailMoved);
+        }
+        phaseStart = Profiler_End(PROFILE_RENDER_SNAKE, phaseStart);
+
+        // Catches up after a restart, a restore or the hint being turned on
+        if (gameState.showPathHint)
+        {
+            Path_Update(&gameState.pathHint, &gameState.sim);
+            Renderer_DrawPathHint(&gameState.pathHint, snake, gameState.gridOffset);
+        }
 
-        // Draw game entities
-        Snake_Render(&playerSnake);
-        Food_Render(&gameFruit);
+        // Smoothed CPU cost of submitting the board
+        double drawMilliseconds = (GetTime() - drawStart) * 1000.0;
+        gameState.drawMilliseconds += 0.1 * (drawMilliseconds - gameState.drawMilliseconds);
 
         // Draw UI overlays
         if (gameState.isPaused)
@@ -153,36 +699,152 @@ void Game_Render(void)
     else
     {
         // Draw game over screen
-        Renderer_DrawGameOver(gameState.playerScore);
+        Renderer_DrawGameOver(gameState.sim.score);
     }
 
+    if (gameState.showFrameTime)
+    {
+        Renderer_DrawFrameTime(GetFrameTime() * 1000.0f, gameState.drawMilliseconds);
+        Renderer_DrawInputLatency(gameState.inputLatencyMilliseconds,
+                                  gameState.inputLatencyAverage,
+                                  gameState.inputLatencyMax);
+    }
+
+    if (gameState.showProfiler)
+    {
+        Renderer_DrawProfiler();
+    }
+    phaseStart = Profiler_End(PROFILE_RENDER_OVERLAY, phaseStart);
+
+    // Includes the wait for vsync
     EndDrawing();
+    Profiler_End(PROFILE_RENDER_PRESENT, phaseStart);
+
+    // A turn applied on the last tick is on screen once this frame is shown
+    if (gameState.isTurnPending)
+    {
+        Game_RecordInputLatency(GetTime());
+    }
 }
 
 // ============================================================================
-// GAME CLEANUP
+// SNAPSHOT AND RESTORE
 // ============================================================================
 
 /*
- * Cleanup game resources
- * Called before program exit
+ * Capture the whole game state in a snapshot (single-snake game only)
+ * 
+ * @param snapshot - Receives the snapshot; snapshot->sim must have been
+ *                   created with Sim_CreateSnapshot for the current board
+ *                   (from an arena other than the game's, which restarts
+ *                   roll back)
  */
-void Game_Cleanup(void)
+void Game_Snapshot(GameSnapshot* snapshot)
 {
-    // No dynamic memory to free in current implementation
-    // Reserved for future resource cleanup
+    assert(snapshot != NULL);
+    assert(!gameState.isMatch);
+
+    Sim_Snapshot(&gameState.sim, &snapshot->sim);
+    snapshot->input = gameState.input;
+    snapshot->freezeCounter = gameState.freezeCounter;
+    snapshot->isGameOver = gameState.isGameOver;
+    snapshot->isPaused = gameState.isPaused;
+    snapshot->seed = gameState.seed;
+    snapshot->replaySize = gameState.replay.size;
+    snapshot->replayLastTick = gameState.replay.lastTick;
+    snapshot->playback = gameState.playback;
+}
+
+/*
+ * Return the game to a snapshot
+ * Within the same round the replay recording is rolled back with the
+ * state; restoring a snapshot from another round stops recording until
+ * the next restart
+ * 
+ * @param snapshot - Snapshot taken by Game_Snapshot
+ */
+void Game_Restore(const GameSnapshot* snapshot)
+{
+    assert(snapshot != NULL);
+    assert(!gameState.isMatch);
+
+    Sim_Restore(&gameState.sim, &snapshot->sim);
+    Renderer_InvalidateBoard();
+
+    // A restored body can differ from the last one at the same tick, so
+    // the distance field rebuilds rather than repairs
+    gameState.pathHint.isCurrent = false;
+    gameState.input = snapshot->input;
+    gameState.isTurnPending = false;
+    gameState.freezeCounter = snapshot->freezeCounter;
+    gameState.movedOnLastTick = false;
+    gameState.isGameOver = snapshot->isGameOver;
+    gameState.isPaused = snapshot->isPaused;
+    gameState.seed = snapshot->seed;
+    gameState.playbackBudget = 0.0f;
+
+    if (gameState.isPlayback)
+    {
+        gameState.playback = snapshot->playback;
+    }
+    else if ((snapshot->seed == gameState.replay.seed) &&
+             (snapshot->replaySize <= gameState.replay.size))
+    {
+        gameState.replay.size = snapshot->replaySize;
+        gameState.replay.lastTick = snapshot->replayLastTick;
+        gameState.replay.isFinished = snapshot->sim.isDead && gameState.replay.isFinished;
+    }
+    else
+    {
+        gameState.replay.isFinished = true;
+    }
+}
+
+/*
+ * Check whether the game over screen is showing
+ * 
+ * @return true once the round (or the replay) has ended
+ */
+bool Game_IsOver(void)
+{
+    return gameState.isGameOver;
+}
+
+/*
+ * Get the smoothed CPU time spent drawing the board each frame
+ * 
+ * @return Draw submission time in milliseconds
+ */
+double Game_GetDrawTime(void)
+{
+    return gameState.drawMilliseconds;
+}
+
+/*
+ * Get the smoothed time from a turn key press to the frame showing it
+ * 
+ * @return Input latency in milliseconds
+ */
+double Game_GetInputLatency(void)
+{
+    return gameState.inputLatencyAverage;
 }
 
 // ============================================================================
-// COMBINED UPDATE AND DRAW
+// GAME CLEANUP
 // ============================================================================
 
 /*
- * Combined update and draw function
- * Used for main game loop and web platform
+ * Cleanup game resources
+ * Called before program exit; a round still in progress is saved, then
+ * the arena releases the simulation and the replay together
  */
-void Game_UpdateAndDraw(void)
+void Game_Cleanup(void)
 {
-    Game_Update();
-    Game_Render();
+    Game_FinishRecording();
+    Replay_Destroy(&gameState.replay);
+    Arena_Destroy(&gameState.arena);
+    gameState.sim.cellCount = 0;
+    gameState.match.cellCount = 0;
+    Renderer_Cleanup();
 }
@@ -0,0 +1,117 @@
+/*
+ * input.c
+ *
+ * Input queue module
+ * Buffers direction changes that arrive between moves so quick double
+ * turns are not lost. Each entry is validated against the heading the
+ * snake will have once the entries before it are applied, and one entry
+ * is consumed per move.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+
+// ============================================================================
+// QUEUE HELPERS
+// ============================================================================
+
+/*
+ * Check whether an action turns onto the horizontal axis
+ */
+static bool InputQueue_IsHorizontal(SimAction action)
+{
+    return (action == SIM_ACTION_LEFT) || (action == SIM_ACTION_RIGHT);
+}
+
+// ============================================================================
+// QUEUE OPERATIONS
+// ============================================================================
+
+/*
+ * Drop every queued turn
+ *
+ * @param queue - Pointer to queue
+ */
+void InputQueue_Clear(InputQueue* queue)
+{
+    assert(queue != NULL);
+
+    queue->head = 0;
+    queue->count = 0;
+}
+
+/*
+ * Queue a direction change if it is a legal turn after the queued ones
+ * Turns onto the axis the snake will already be moving along (including
+ * reversals) and turns arriving while the queue is full are rejected
+ *
+ * @param queue - Pointer to queue
+ * @param isMovingHorizontally - Current heading of the snake the turns
+ *                               will be applied to
+ * @param action - Requested direction
+ * @param timestamp - Caller's clock at the key press, for latency tracking
+ * @return true if the turn was queued
+ */
+bool InputQueue_Push(InputQueue* queue, bool isMovingHorizontally, SimAction action, double timestamp)
+{
+    assert(queue != NULL);
+
+    if ((action == SIM_ACTION_NONE) || (queue->count == INPUT_QUEUE_CAPACITY))
+    {
+        return false;
+    }
+
+    if (queue->count == 0)
+    {
+        if (InputQueue_IsHorizontal(action) == isMovingHorizontally)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        int last = (queue->head + queue->count - 1) % INPUT_QUEUE_CAPACITY;
+        if (InputQueue_IsHorizontal(action) == InputQueue_IsHorizontal((SimAction)queue->actions[last]))
+        {
+            return false;
+        }
+    }
+
+    int slot = (queue->head + queue->count) % INPUT_QUEUE_CAPACITY;
+    queue->actions[slot] = (uint8_t)action;
+    queue->timestamps[slot] = timestamp;
+    queue->count++;
+
+    return true;
+}
+
+/*
+ * Take the oldest queued turn for the next move
+ *
+ * @param queue - Pointer to queue
+ * @param timestamp - Receives the turn's timestamp (may be NULL)
+ * @return Oldest queued action, or SIM_ACTION_NONE if the queue is empty
+ */
+SimAction InputQueue_Pop(InputQueue* queue, double* timestamp)
+{
+    assert(queue != NULL);
+
+    if (queue->count == 0)
+    {
+        return SIM_ACTION_NONE;
+    }
+
+    SimAction action = (SimAction)queue->actions[queue->head];
+    if (timestamp != NULL)
+    {
+        *timestamp = queue->timestamps[queue->head];
+    }
+
+    queue->head = (queue->head + 1) % INPUT_QUEUE_CAPACITY;
+    queue->count--;
+
+    return action;
+}
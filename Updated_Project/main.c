@@ -2,40 +2,444 @@
  * main.c
  * 
  * Main entry point for Snake Game
- * Handles window creation and main game loop
+ * Handles window creation, command line options and main game loop.
+ * The loop runs the game logic at a fixed TICK_RATE from a time
+ * accumulator and renders at the display refresh rate in between.
  * 
  * Course: Advanced Programming Lab
  * Date: February 2026
  */
 
+#define _POSIX_C_SOURCE 200112L
+
 #include "snake_game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HEADLESS_BOT_STALL_BOARDS 4  // Moves without food, in boards, that end a headless round
 
 #if defined(PLATFORM_WEB)
 #include <emscripten/emscripten.h>
 #endif
 
+static double tickAccumulator = 0.0;
+
+/*
+ * Options taken from the command line
+ */
+typedef struct {
+    uint64_t seed;
+    const char* recordPath;
+    const char* replayPath;
+    const char* profilePath;
+    float playbackRate;
+    int columns;
+    int rows;
+    int snakeCount;
+    int playerCount;
+    int bot;
+    bool useMcts;
+    int mctsBudget;
+    int threadCount;
+    bool headless;
+    const char* capturePath;
+    bool captureRaw;
+    int frameLimit;
+} MainOptions;
+
+/*
+ * Read options from the command line
+ *   --seed <value>    seed for the first round (default: the clock)
+ *   --record <file>   save each finished round as a replay
+ *   --replay <file>   play a replay back instead of reading the keyboard
+ *   --rate <x>        playback speed multiplier (default 1)
+ *   --headless        with --replay: re-simulate without a window;
+ *                     with --bot: play one round without a window
+ *   --profile <file>  profiler CSV written on exit (default PROFILE_CSV_PATH)
+ *   --board <WxH>     board size in cells, up to BOARD_MAX_SIZE per side
+ *   --snakes <n>      play a match of n snakes instead of the single game
+ *   --players <n>     local players in a match, 0 to MATCH_MAX_PLAYERS
+ *                     (default 1); the other snakes are bots
+ *   --bot <name>      let a built-in bot play: greedy, path, cycle or mcts
+ *   --budget <us>     mcts search time per move (default MCTS_DEFAULT_BUDGET_US)
+ *   --threads <n>     mcts trees searched in parallel (default 1)
+ *   --capture <path>  save every frame as <path>NNNNNN.png and stop at
+ *                     game over
+ *   --raw             with --capture: raw RGBA frames (.rgba) instead
+ *   --frames <n>      stop after n frames (default: no limit)
+ * 
+ * @param argc - Argument count
+ * @param argv - Argument values
+ * @return Parsed options
+ */
+static MainOptions Main_ParseOptions(int argc, char** argv)
+{
+    MainOptions options = {
+        (uint64_t)time(NULL), NULL, NULL, PROFILE_CSV_PATH, 1.0f,
+        DEFAULT_GRID_COLUMNS, DEFAULT_GRID_ROWS, 0, 1,
+        -1, false, MCTS_DEFAULT_BUDGET_US, 1, false,
+        NULL, false, 0
+    };
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(argv[i], "--seed") == 0) && hasValue)
+        {
+            options.seed = (uint64_t)strtoull(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "--record") == 0) && hasValue)
+        {
+            options.recordPath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--replay") == 0) && hasValue)
+        {
+            options.replayPath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--profile") == 0) && hasValue)
+        {
+            options.profilePath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--rate") == 0) && hasValue)
+        {
+            options.playbackRate = strtof(argv[++i], NULL);
+        }
+        else if ((strcmp(argv[i], "--board") == 0) && hasValue)
+        {
+            if (sscanf(argv[++i], "%dx%d", &options.columns, &options.rows) != 2)
+            {
+                options.columns = 0;
+            }
+        }
+        else if ((strcmp(argv[i], "--snakes") == 0) && hasValue)
+        {
+            options.snakeCount = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--players") == 0) && hasValue)
+        {
+            options.playerCount = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--bot") == 0) && hasValue)
+        {
+            const char* name = argv[++i];
+            options.bot = CONTROLLER_BOT_COUNT;
+            options.useMcts = (strcmp(name, "mcts") == 0);
+            for (int bot = 0; bot < CONTROLLER_BOT_COUNT; bot++)
+            {
+                if (strcmp(name, Controller_GetBotName((ControllerBot)bot)) == 0)
+                {
+                    options.bot = bot;
+                }
+            }
+        }
+        else if ((strcmp(argv[i], "--budget") == 0) && hasValue)
+        {
+            options.mctsBudget = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--threads") == 0) && hasValue)
+        {
+            options.threadCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--headless") == 0)
+        {
+            options.headless = true;
+        }
+        else if ((strcmp(argv[i], "--capture") == 0) && hasValue)
+        {
+            options.capturePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--raw") == 0)
+        {
+            options.captureRaw = true;
+        }
+        else if ((strcmp(argv[i], "--frames") == 0) && hasValue)
+        {
+            options.frameLimit = atoi(argv[++i]);
+        }
+    }
+
+    if (!(options.playbackRate > 0.0f))
+    {
+        options.playbackRate = 1.0f;
+    }
+
+    return options;
+}
+
+/*
+ * Re-simulate a replay as fast as possible and print the outcome
+ * 
+ * @param path - Replay file
+ * @return Process exit code
+ */
+static int Main_RunHeadlessReplay(const char* path)
+{
+    Arena arena;
+    Replay replay;
+    SimState sim;
+
+    Arena_Initialize(&arena, 0);
+    Replay_Initialize(&replay, &arena);
+    if (!Replay_Load(&replay, path))
+    {
+        fprintf(stderr, "Cannot read replay: %s\n", path);
+        Arena_Destroy(&arena);
+        return 1;
+    }
+
+    Utils_SetBoardSize(replay.columns, replay.rows);
+    if (!Sim_Create(&sim, &arena))
+    {
+        fprintf(stderr, "Out of memory for a %dx%d board\n", replay.columns, replay.rows);
+        Arena_Destroy(&arena);
+        return 1;
+    }
+
+    clock_t start = clock();
+    bool matches = Replay_Simulate(&replay, &sim);
+    double milliseconds = 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Replay: seed %llu, %dx%d board, %zu bytes, %d ticks, score %d, %s (%.3f ms)\n",
+           (unsigned long long)replay.seed, replay.columns, replay.rows, replay.size,
+           sim.tickCount, sim.score, matches ? "consistent" : "INCONSISTENT", milliseconds);
+
+    Arena_Destroy(&arena);
+    return matches ? 0 : 2;
+}
+
+/*
+ * Let a bot play one round as fast as possible and print the outcome
+ * The round also ends when the snake goes HEADLESS_BOT_STALL_BOARDS
+ * times the board's cell count moves without food
+ * 
+ * @param options - Options naming the bot and the seed
+ * @param pool - Pool for the tree search player, or NULL
+ * @return Process exit code
+ */
+static int Main_RunHeadlessBot(const MainOptions* options, ThreadPool* pool)
+{
+    Arena arena;
+    SimState sim;
+    Controller controller;
+    MctsAgent mcts;
+
+    Arena_Initialize(&arena, 0);
+    bool isCreated = Sim_Create(&sim, &arena);
+    if (isCreated && options->useMcts)
+    {
+        isCreated = Mcts_Create(&mcts, &arena, options->mctsBudget, pool);
+        Mcts_AttachController(&controller, &mcts);
+    }
+    else if (isCreated)
+    {
+        isCreated = Controller_CreateBot(&controller, (ControllerBot)options->bot, &arena);
+    }
+
+    if (!isCreated)
+    {
+        fprintf(stderr, "Out of memory for a %dx%d board\n", Utils_GetGridColumns(), Utils_GetGridRows());
+        Arena_Destroy(&arena);
+        return 1;
+    }
+
+    Sim_Initialize(&sim, options->seed);
+
+    int stallLimit = HEADLESS_BOT_STALL_BOARDS * sim.cellCount;
+    int mealTick = 0;
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (!sim.isDead && sim.food.active && (sim.tickCount - mealTick < stallLimit))
+    {
+        if (Sim_Step(&sim, Controller_Decide(&controller, &sim)) & SIM_EVENT_ATE)
+        {
+            mealTick = sim.tickCount;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double microseconds = (double)(end.tv_sec - start.tv_sec) * 1e6 +
+                          (double)(end.tv_nsec - start.tv_nsec) / 1e3;
+
+    const char* outcome = sim.isDead ? "died"
+                        : !sim.food.active ? "filled the board" : "stalled";
+    printf("Bot %s: seed %llu, %dx%d board, %d ticks, score %d, %s (%.3f us per move)\n",
+           options->useMcts ? "mcts" : Controller_GetBotName((ControllerBot)options->bot),
+           (unsigned long long)options->seed, Utils_GetGridColumns(), Utils_GetGridRows(),
+           sim.tickCount, sim.score, outcome,
+           (sim.tickCount > 0) ? microseconds / sim.tickCount : 0.0);
+
+    Arena_Destroy(&arena);
+    return 0;
+}
+
+/*
+ * Run one rendered frame
+ * Feeds the frame time into the tick accumulator, runs every whole tick it
+ * holds and renders with the leftover fraction for interpolation. Shared
+ * by the desktop loop and the web main loop so both play at the same speed.
+ */
+static void Main_RunFrame(void)
+{
+    uint64_t frameStart = Profiler_Begin();
+
+    Game_Update();
+
+    // Clamp long stalls (window drag, breakpoint) instead of fast-forwarding
+    tickAccumulator += GetFrameTime();
+    if (tickAccumulator > MAX_FRAME_SECONDS)
+    {
+        tickAccumulator = MAX_FRAME_SECONDS;
+    }
+
+    while (tickAccumulator >= TICK_SECONDS)
+    {
+        Game_Tick();
+        tickAccumulator -= TICK_SECONDS;
+    }
+
+    Game_Render((float)(tickAccumulator / TICK_SECONDS));
+
+    Profiler_End(PROFILE_FRAME, frameStart);
+    Profiler_EndFrame();
+}
+
 /*
  * Program main entry point
  */
-int main(void)
+int main(int argc, char** argv)
 {
+    MainOptions options = Main_ParseOptions(argc, argv);
+
+    if (!Utils_SetBoardSize(options.columns, options.rows))
+    {
+        fprintf(stderr, "Board must be %d to %d cells per side\n", BOARD_MIN_SIZE, BOARD_MAX_SIZE);
+        return 1;
+    }
+
+    if ((options.replayPath != NULL) && options.headless)
+    {
+        return Main_RunHeadlessReplay(options.replayPath);
+    }
+
+    ThreadPool* pool = NULL;
+    if (options.bot >= 0)
+    {
+        bool isValidBot = ((options.bot < CONTROLLER_BOT_COUNT) || options.useMcts) &&
+                          (options.mctsBudget > 0) && (options.threadCount >= 1) &&
+                          (options.snakeCount == 0) && (options.replayPath == NULL);
+        if (!isValidBot)
+        {
+            fprintf(stderr, "--bot takes greedy, path, cycle or mcts (with a positive --budget "
+                            "and --threads), without --snakes or --replay\n");
+            return 1;
+        }
+
+        if (options.useMcts && (options.threadCount > 1))
+        {
+            pool = ThreadPool_Create(options.threadCount);
+            if (pool == NULL)
+            {
+                fprintf(stderr, "Cannot start %d threads\n", options.threadCount);
+                return 1;
+            }
+        }
+
+        if (options.headless)
+        {
+            int exitCode = Main_RunHeadlessBot(&options, pool);
+            ThreadPool_Destroy(pool);
+            return exitCode;
+        }
+
+        if (options.useMcts)
+        {
+            Game_SetMcts(options.mctsBudget, pool);
+        }
+        else
+        {
+            Game_SetBot((ControllerBot)options.bot);
+        }
+    }
+
+    if (options.snakeCount != 0)
+    {
+        bool isValidMatch = (options.snakeCount > 0) && (options.snakeCount <= MATCH_MAX_SNAKES) &&
+                            (options.playerCount >= 0) && (options.playerCount <= MATCH_MAX_PLAYERS) &&
+                            (options.playerCount <= options.snakeCount) &&
+                            (options.replayPath == NULL);
+        if (!isValidMatch)
+        {
+            fprintf(stderr, "A match takes 1 to %d snakes and 0 to %d players, without --replay\n",
+                    MATCH_MAX_SNAKES, MATCH_MAX_PLAYERS);
+            return 1;
+        }
+
+        Game_SetMatchMode(options.snakeCount, options.playerCount);
+    }
+
+    Profiler_SetEnabled(true);
+    SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Classic Game: Snake - Refactored Edition");
 
-    Game_Initialize();
+    if (options.replayPath != NULL)
+    {
+        if (!Game_StartPlayback(options.replayPath, options.playbackRate))
+        {
+            fprintf(stderr, "Cannot read replay: %s\n", options.replayPath);
+            CloseWindow();
+            return 1;
+        }
+    }
+    else
+    {
+        // Printed so the session can be reproduced with --seed
+        printf("Seed: %llu\n", (unsigned long long)options.seed);
+        Game_SetRecordPath(options.recordPath);
+        if (!Game_Initialize(options.seed))
+        {
+            fprintf(stderr, "Out of memory for a %dx%d board\n", options.columns, options.rows);
+            CloseWindow();
+            return 1;
+        }
+    }
 
 #if defined(PLATFORM_WEB)
-    emscripten_set_main_loop(Game_UpdateAndDraw, 60, 1);
+    // Zero lets the browser drive frames at the display refresh rate
+    emscripten_set_main_loop(Main_RunFrame, 0, 1);
 #else
-    SetTargetFPS(TARGET_FPS);
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    SetTargetFPS((refreshRate > 0) ? refreshRate : FALLBACK_FPS);
     
-    while (!WindowShouldClose())
+    int frame = 0;
+    while (!WindowShouldClose() && ((options.frameLimit <= 0) || (frame < options.frameLimit)))
     {
-        Game_UpdateAndDraw();
+        Main_RunFrame();
+
+        // The last frame saved is the game over screen
+        if (options.capturePath != NULL)
+        {
+            TakeScreenshot(TextFormat("%s%06d.%s", options.capturePath, frame,
+                                      options.captureRaw ? "rgba" : "png"));
+            if (Game_IsOver())
+            {
+                break;
+            }
+        }
+        frame++;
     }
 #endif
 
     Game_Cleanup();
     CloseWindow();
+    ThreadPool_Destroy(pool);
+
+    if (!Profiler_WriteCsv(options.profilePath))
+    {
+        fprintf(stderr, "Cannot write profile: %s\n", options.profilePath);
+    }
 
     return 0;
 }
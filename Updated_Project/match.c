@@ -0,0 +1,461 @@
+/*
+ * match.c
+ *
+ * Multi-snake match module
+ * Many snakes (local players and bots) share one wrap-around board.
+ * Every cell records which snake covers it, so a head entering a cell
+ * resolves head-vs-body collisions with one lookup, and heads entering
+ * the same cell meet in a per-tick claim grid. A tick therefore costs
+ * O(snakes) regardless of snake length; only a death walks the body it
+ * clears.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <string.h>
+
+#define MATCH_BOT_FOOD_CHOICES 16   // Food items a bot considers per move
+
+// Direction for each SimAction (SIM_ACTION_NONE keeps the heading)
+static const int8_t actionDirectionX[] = { 0, 0, 0, -1, 1 };
+static const int8_t actionDirectionY[] = { 0, -1, 1, 0, 0 };
+
+// ============================================================================
+// BOARD HELPERS
+// ============================================================================
+
+/*
+ * Cell one step from a cell, wrapping around the board edges
+ */
+static uint32_t Match_StepCell(uint32_t cell, int directionX, int directionY)
+{
+    int columns = Utils_GetGridColumns();
+    int rows = Utils_GetGridRows();
+    int column = (int)cell % columns + directionX;
+    int row = (int)cell / columns + directionY;
+
+    if (column >= columns) column = 0;
+    else if (column < 0)   column = columns - 1;
+
+    if (row >= rows)   row = 0;
+    else if (row < 0)  row = rows - 1;
+
+    return (uint32_t)(row * columns + column);
+}
+
+/*
+ * Steps between two cells on a wrap-around board
+ */
+static int Match_Distance(uint32_t from, uint32_t to)
+{
+    int columns = Utils_GetGridColumns();
+    int rows = Utils_GetGridRows();
+    int dx = (int)from % columns - (int)to % columns;
+    int dy = (int)from / columns - (int)to / columns;
+
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    if (dx > columns - dx) dx = columns - dx;
+    if (dy > rows - dy) dy = rows - dy;
+
+    return dx + dy;
+}
+
+/*
+ * Place food on a random free cell; nothing happens on a full board
+ * A food cell is not part of any body, so its nextCell link holds the
+ * food's index instead
+ */
+static void Match_SpawnFood(MatchState* match, int index)
+{
+    Food* food = &match->foods[index];
+
+    Food_Spawn(food, &match->freeCells, &match->rng);
+    if (food->active)
+    {
+        match->owner[food->cell] = MATCH_CELL_FOOD;
+        match->nextCell[food->cell] = (uint32_t)index;
+        FreeCells_Remove(&match->freeCells, (int)food->cell);
+    }
+}
+
+// ============================================================================
+// SNAKE LIFECYCLE
+// ============================================================================
+
+/*
+ * Put a one-cell snake on a random free cell with a random heading
+ * The snake stays dead (and tries again next tick) if the board is full
+ *
+ * @param match - Pointer to match
+ * @param index - Snake to spawn
+ */
+static void Match_SpawnSnake(MatchState* match, int index)
+{
+    MatchSnake* snake = &match->snakes[index];
+
+    if (match->freeCells.count == 0)
+    {
+        snake->respawnCountdown = 1;
+        return;
+    }
+
+    uint32_t cell = match->freeCells.cells[Rng_NextBounded(&match->rng, (uint32_t)match->freeCells.count)];
+    int action = SIM_ACTION_UP + (int)Rng_NextBounded(&match->rng, 4);
+
+    FreeCells_Remove(&match->freeCells, (int)cell);
+    match->owner[cell] = (uint16_t)(index + 1);
+
+    snake->headCell = cell;
+    snake->tailCell = cell;
+    snake->length = 1;
+    snake->directionX = actionDirectionX[action];
+    snake->directionY = actionDirectionY[action];
+    snake->isAlive = true;
+    snake->respawnCountdown = 0;
+    match->aliveCount++;
+}
+
+/*
+ * Clear a dead snake's body from the board
+ * Walks the body once, so it costs the snake's length
+ *
+ * @param match - Pointer to match
+ * @param index - Snake that died
+ */
+static void Match_RemoveSnake(MatchState* match, int index)
+{
+    MatchSnake* snake = &match->snakes[index];
+    uint32_t cell = snake->tailCell;
+
+    for (uint32_t i = 0; i < snake->length; i++)
+    {
+        match->owner[cell] = MATCH_CELL_EMPTY;
+        FreeCells_Add(&match->freeCells, (int)cell);
+        cell = match->nextCell[cell];
+    }
+
+    snake->isAlive = false;
+    snake->length = 0;
+    snake->respawnCountdown = match->respawnTicks;
+    match->aliveCount--;
+}
+
+// ============================================================================
+// CREATION AND INITIALIZATION
+// ============================================================================
+
+/*
+ * Carve a match for the current board size out of an arena and start it
+ * with seed 0. Memory grows with the board: 16 bytes per cell.
+ *
+ * @param match - Pointer to match to create
+ * @param arena - Arena to allocate from
+ * @param snakeCount - Snakes on the board, 1 to MATCH_MAX_SNAKES
+ * @param foodCount - Food items kept on the board at once
+ * @return true on success, false if memory could not be allocated
+ */
+bool Match_Create(MatchState* match, Arena* arena, int snakeCount, int foodCount)
+{
+    assert(match != NULL);
+    assert(arena != NULL);
+    assert(snakeCount > 0 && snakeCount <= MATCH_MAX_SNAKES);
+    assert(foodCount > 0);
+
+    memset(match, 0, sizeof(MatchState));
+
+    size_t cells = (size_t)Utils_GetCellCount();
+    match->snakeCount = snakeCount;
+    match->foodCount = foodCount;
+    match->respawnTicks = MATCH_RESPAWN_TICKS;
+    match->cellCount = (int)cells;
+
+    match->snakes = Arena_Allocate(arena, (size_t)snakeCount * sizeof(MatchSnake), sizeof(uint32_t));
+    match->targetCell = Arena_Allocate(arena, (size_t)snakeCount * sizeof(uint32_t), sizeof(uint32_t));
+    match->foods = Arena_Allocate(arena, (size_t)foodCount * sizeof(Food), sizeof(uint32_t));
+    match->owner = Arena_Allocate(arena, cells * sizeof(uint16_t), sizeof(uint16_t));
+    match->claim = Arena_Allocate(arena, cells * sizeof(uint16_t), sizeof(uint16_t));
+    match->nextCell = Arena_Allocate(arena, cells * sizeof(uint32_t), sizeof(uint32_t));
+    match->freeCells.cells = Arena_Allocate(arena, cells * sizeof(uint32_t), sizeof(uint32_t));
+    match->freeCells.slotOf = Arena_Allocate(arena, cells * sizeof(uint32_t), sizeof(uint32_t));
+
+    if (!match->snakes || !match->targetCell || !match->foods || !match->owner ||
+        !match->claim || !match->nextCell || !match->freeCells.cells ||
+        !match->freeCells.slotOf)
+    {
+        return false;
+    }
+
+    Match_Initialize(match, 0);
+    return true;
+}
+
+/*
+ * Reset a match: every snake respawns on a random cell and the food
+ * is laid out again
+ *
+ * @param match - Pointer to match created for the current board
+ * @param seed - Seed for the match's random stream
+ */
+void Match_Initialize(MatchState* match, uint64_t seed)
+{
+    assert(match != NULL);
+    assert(match->owner != NULL);
+    assert(match->cellCount == Utils_GetCellCount());
+
+    Rng_Seed(&match->rng, seed, 0);
+    match->seed = seed;
+    match->tickCount = 0;
+    match->aliveCount = 0;
+
+    memset(match->owner, 0, (size_t)match->cellCount * sizeof(uint16_t));
+    memset(match->claim, 0, (size_t)match->cellCount * sizeof(uint16_t));
+    FreeCells_Initialize(&match->freeCells, match->cellCount);
+
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        memset(&match->snakes[i], 0, sizeof(MatchSnake));
+        Match_SpawnSnake(match, i);
+    }
+
+    for (int i = 0; i < match->foodCount; i++)
+    {
+        Food_Initialize(&match->foods[i]);
+        Match_SpawnFood(match, i);
+    }
+}
+
+// ============================================================================
+// MATCH STEP
+// ============================================================================
+
+/*
+ * Advance every snake by one move
+ * Heads entering the same cell all die. A head entering a body cell dies,
+ * except for the tail cell of a snake that is not eating this tick, which
+ * is vacated by the same move; two one-cell snakes swapping cells still
+ * meet head-on and both die. Dead snakes leave the board at once and
+ * respawn later; eaten food is replaced at the end of the tick.
+ *
+ * @param match - Pointer to match to advance
+ * @param actions - One action per snake (ignored for dead snakes)
+ * @return Number of snakes that died on this tick
+ */
+int Match_Step(MatchState* match, const SimAction* actions)
+{
+    assert(match != NULL);
+    assert(actions != NULL);
+
+    int deaths = 0;
+    match->tickCount++;
+
+    // Steer, pick the cell each head enters and claim it; a second claim
+    // on a cell is a head-on collision for both
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        MatchSnake* snake = &match->snakes[i];
+        snake->events = SIM_EVENT_NONE;
+        if (!snake->isAlive)
+        {
+            continue;
+        }
+
+        int action = (int)actions[i];
+        bool turnsHorizontal = (action == SIM_ACTION_LEFT) || (action == SIM_ACTION_RIGHT);
+        if ((action != SIM_ACTION_NONE) && (turnsHorizontal == (snake->directionX == 0)))
+        {
+            snake->directionX = actionDirectionX[action];
+            snake->directionY = actionDirectionY[action];
+        }
+
+        uint32_t target = Match_StepCell(snake->headCell, snake->directionX, snake->directionY);
+        match->targetCell[i] = target;
+
+        if (match->claim[target] == 0)
+        {
+            match->claim[target] = (uint16_t)(i + 1);
+        }
+        else
+        {
+            match->snakes[match->claim[target] - 1].events = SIM_EVENT_DIED;
+            snake->events = SIM_EVENT_DIED;
+        }
+    }
+
+    // Head-vs-body through the ownership grid; food decides who grows
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        MatchSnake* snake = &match->snakes[i];
+        if (!snake->isAlive)
+        {
+            continue;
+        }
+
+        uint32_t target = match->targetCell[i];
+        uint16_t owner = match->owner[target];
+        match->claim[target] = 0;
+
+        if (owner == MATCH_CELL_FOOD)
+        {
+            snake->events |= SIM_EVENT_ATE;
+        }
+        else if (owner != MATCH_CELL_EMPTY)
+        {
+            // A tail that moves on is safe to enter, unless it belongs to
+            // a one-cell snake moving into this head (a head-on crossing);
+            // a longer snake entering this head hits the neck and dies alone
+            const MatchSnake* other = &match->snakes[owner - 1];
+            uint32_t otherTarget = match->targetCell[owner - 1];
+            bool otherEats = (match->owner[otherTarget] == MATCH_CELL_FOOD);
+            if ((target != other->tailCell) || otherEats ||
+                ((other->length == 1) && (otherTarget == snake->headCell)))
+            {
+                snake->events |= SIM_EVENT_DIED;
+            }
+        }
+    }
+
+    // Clear the dead, then vacate the tails of snakes that do not grow,
+    // then move every surviving head
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        if (match->snakes[i].isAlive && (match->snakes[i].events & SIM_EVENT_DIED))
+        {
+            Match_RemoveSnake(match, i);
+            deaths++;
+        }
+    }
+
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        MatchSnake* snake = &match->snakes[i];
+        if (!snake->isAlive || (snake->events & SIM_EVENT_ATE))
+        {
+            continue;
+        }
+
+        uint32_t tail = snake->tailCell;
+        snake->tailCell = (snake->length > 1) ? match->nextCell[tail] : match->targetCell[i];
+        match->owner[tail] = MATCH_CELL_EMPTY;
+        FreeCells_Add(&match->freeCells, (int)tail);
+    }
+
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        MatchSnake* snake = &match->snakes[i];
+        if (!snake->isAlive)
+        {
+            continue;
+        }
+
+        uint32_t target = match->targetCell[i];
+        if (snake->events & SIM_EVENT_ATE)
+        {
+            match->foods[match->nextCell[target]].active = false;
+            snake->length++;
+            snake->score++;
+        }
+        else
+        {
+            FreeCells_Remove(&match->freeCells, (int)target);
+        }
+
+        match->owner[target] = (uint16_t)(i + 1);
+        match->nextCell[snake->headCell] = target;
+        snake->headCell = target;
+    }
+
+    // Respawn the dead whose wait is over and replace eaten food
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        MatchSnake* snake = &match->snakes[i];
+        if (!snake->isAlive && (snake->respawnCountdown > 0) && (--snake->respawnCountdown == 0))
+        {
+            Match_SpawnSnake(match, i);
+        }
+    }
+
+    for (int i = 0; i < match->foodCount; i++)
+    {
+        if (!match->foods[i].active)
+        {
+            Match_SpawnFood(match, i);
+        }
+    }
+
+    return deaths;
+}
+
+// ============================================================================
+// BUILT-IN BOT
+// ============================================================================
+
+/*
+ * Pick a move for a bot-controlled snake
+ * Heads for the nearest of up to MATCH_BOT_FOOD_CHOICES food items (each
+ * snake looks at its own run of the food list, so bots spread out),
+ * never turns back and avoids cells that are taken now (a tail about to
+ * move counts as taken). The cost is constant per bot, so steering every
+ * snake stays O(snakes).
+ *
+ * @param match - Pointer to match
+ * @param snakeIndex - Snake to steer
+ * @return Action for the snake's next move
+ */
+SimAction Match_ChooseBotAction(const MatchState* match, int snakeIndex)
+{
+    assert(match != NULL);
+    assert(snakeIndex >= 0 && snakeIndex < match->snakeCount);
+
+    const MatchSnake* snake = &match->snakes[snakeIndex];
+    if (!snake->isAlive)
+    {
+        return SIM_ACTION_NONE;
+    }
+
+    uint32_t goal = snake->headCell;
+    int goalDistance = -1;
+    int choices = (match->foodCount < MATCH_BOT_FOOD_CHOICES) ? match->foodCount : MATCH_BOT_FOOD_CHOICES;
+    for (int choice = 0; choice < choices; choice++)
+    {
+        const Food* food = &match->foods[(snakeIndex + choice) % match->foodCount];
+        int distance = Match_Distance(snake->headCell, food->cell);
+        if (food->active && ((goalDistance < 0) || (distance < goalDistance)))
+        {
+            goal = food->cell;
+            goalDistance = distance;
+        }
+    }
+
+    // Straight ahead first, so ties keep the heading
+    SimAction best = SIM_ACTION_NONE;
+    int bestDistance = -1;
+    for (int action = SIM_ACTION_NONE; action <= SIM_ACTION_RIGHT; action++)
+    {
+        int directionX = (action == SIM_ACTION_NONE) ? snake->directionX : actionDirectionX[action];
+        int directionY = (action == SIM_ACTION_NONE) ? snake->directionY : actionDirectionY[action];
+        if ((action != SIM_ACTION_NONE) && ((directionX != 0) == (snake->directionX != 0)))
+        {
+            continue;
+        }
+
+        uint32_t cell = Match_StepCell(snake->headCell, directionX, directionY);
+        uint16_t owner = match->owner[cell];
+        if ((owner != MATCH_CELL_EMPTY) && (owner != MATCH_CELL_FOOD))
+        {
+            continue;
+        }
+
+        int distance = Match_Distance(cell, goal);
+        if ((bestDistance < 0) || (distance < bestDistance))
+        {
+            best = (SimAction)action;
+            bestDistance = distance;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,532 @@
+/*
+ * mcts.c
+ *
+ * Monte Carlo tree search player
+ * Each tree copies the live game into a scratch game once per decision.
+ * Every playout walks the tree by UCB1 to a leaf, expands it and plays on
+ * with a cheap food-seeking random policy, then rewinds the scratch game
+ * through its move journal, so a playout costs its moves and not the
+ * board. Food that appears after the live move is not known yet, so each
+ * playout reseeds the copy's generator and the tree averages over many
+ * possible food placements. The most visited first move wins.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MCTS_TREE_NODES          65536  // Node pool of one tree
+#define MCTS_MAX_DEPTH           64     // Deepest tree level expanded
+#define MCTS_MIN_HORIZON         16     // Shortest playout look-ahead in moves
+#define MCTS_MOVES               3      // Straight on and the two turns
+#define MCTS_CHECK_INTERVAL      4      // Playouts between clock reads
+#define MCTS_EXPLORATION         0.7f   // UCB1 exploration constant
+#define MCTS_MEAL_DISCOUNT       0.97f  // Share of the food reward kept per move it takes
+#define MCTS_RANDOM_MOVE_PERCENT 25     // Playout moves that ignore the food
+#define MCTS_CACHE_LINE          64
+
+/*
+ * One tree node: the move that leads to it and its playout statistics
+ * The children of a node are contiguous in the pool. The root is node 0
+ * and nobody's child, so firstChild is 0 until the node is expanded.
+ */
+typedef struct {
+    uint32_t firstChild;
+    uint32_t visits;
+    float valueSum;
+    uint8_t action;
+    uint8_t childCount;
+} MctsNode;
+
+/*
+ * Search state of one root-parallel worker
+ */
+struct MctsTree {
+    MctsNode* nodes;
+    int nodeCount;
+    int playoutCount;
+    SimState scratch;
+    SimJournal journal;   // Moves of the current playout
+    Rng rng;
+};
+
+/*
+ * Progress of one playout from the live game
+ */
+typedef struct {
+    int moves;
+    float discount;     // Food reward still on offer at the next move
+    float mealValue;    // Food reward earned by the first meal, 0 before it
+} MctsPlay;
+
+static const int actionDirectionX[] = { 0, 0, 0, -1, 1 };
+static const int actionDirectionY[] = { 0, -1, 1, 0, 0 };
+
+// ============================================================================
+// BOARD HELPERS
+// ============================================================================
+
+/*
+ * Read a monotonic clock in nanoseconds
+ */
+static uint64_t Mcts_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * List the moves that lead somewhere different: straight on (NONE) and
+ * the two turns; the reverse and the current heading change nothing
+ *
+ * @param snake - Snake about to move
+ * @param moves - Receives MCTS_MOVES actions, straight on first
+ */
+static void Mcts_GetMoves(const Snake* snake, SimAction moves[MCTS_MOVES])
+{
+    bool isHorizontal = (snake->directionX != 0);
+
+    moves[0] = SIM_ACTION_NONE;
+    moves[1] = isHorizontal ? SIM_ACTION_UP : SIM_ACTION_LEFT;
+    moves[2] = isHorizontal ? SIM_ACTION_DOWN : SIM_ACTION_RIGHT;
+}
+
+/*
+ * Moves between two coordinates on one wrapping axis
+ */
+static int Mcts_GetAxisDistance(int from, int to, int size)
+{
+    int distance = abs(from - to);
+    return (2 * distance > size) ? size - distance : distance;
+}
+
+// ============================================================================
+// PLAYOUTS
+// ============================================================================
+
+/*
+ * Pick a playout move: mostly the safe move closest to the food, now and
+ * then any safe move. Only the next cell is checked, so playouts stay
+ * cheap and the tree has to find the traps.
+ *
+ * @param agent - Agent holding the board size
+ * @param tree - Tree whose scratch game is being played
+ * @return Action for the scratch game's next move
+ */
+static SimAction Mcts_ChoosePlayoutMove(const MctsAgent* agent, MctsTree* tree)
+{
+    const SimState* sim = &tree->scratch;
+    const Snake* snake = &sim->snake;
+    uint32_t columns = (uint32_t)agent->columns;
+    uint32_t head = snake->body[snake->headIndex];
+    uint32_t tail = (uint32_t)Snake_GetSegmentCell(snake, (int)snake->length - 1);
+    int headColumn = (int)(head % columns);
+    int headRow = (int)(head / columns);
+    int foodColumn = (int)(sim->food.cell % columns);
+    int foodRow = (int)(sim->food.cell / columns);
+
+    SimAction moves[MCTS_MOVES];
+    SimAction safeMoves[MCTS_MOVES];
+    int safeCount = 0;
+    SimAction best = SIM_ACTION_NONE;
+    int bestDistance = INT_MAX;
+
+    Mcts_GetMoves(snake, moves);
+    for (int i = 0; i < MCTS_MOVES; i++)
+    {
+        SimAction move = moves[i];
+        int column = headColumn + ((move == SIM_ACTION_NONE) ? snake->directionX : actionDirectionX[move]);
+        int row = headRow + ((move == SIM_ACTION_NONE) ? snake->directionY : actionDirectionY[move]);
+
+        if (column >= agent->columns) column = 0;
+        else if (column < 0)          column = agent->columns - 1;
+
+        if (row >= agent->rows) row = 0;
+        else if (row < 0)       row = agent->rows - 1;
+
+        // The tail moves on before the head arrives
+        uint32_t cell = (uint32_t)row * columns + (uint32_t)column;
+        if ((cell != tail) && Occupancy_IsOccupied(snake->occupancy, (int)cell))
+        {
+            continue;
+        }
+
+        safeMoves[safeCount++] = move;
+        int distance = !sim->food.active ? 0
+                     : Mcts_GetAxisDistance(column, foodColumn, agent->columns) +
+                       Mcts_GetAxisDistance(row, foodRow, agent->rows);
+        if (distance < bestDistance)
+        {
+            best = move;
+            bestDistance = distance;
+        }
+    }
+
+    if ((safeCount > 1) && (Rng_NextBounded(&tree->rng, 100) < MCTS_RANDOM_MOVE_PERCENT))
+    {
+        return safeMoves[Rng_NextBounded(&tree->rng, (uint32_t)safeCount)];
+    }
+
+    return best;
+}
+
+/*
+ * Step the scratch game and note the first meal
+ *
+ * @param tree - Tree whose scratch game is being played
+ * @param play - Playout progress
+ * @param action - Action for the move
+ */
+static void Mcts_Step(MctsTree* tree, MctsPlay* play, SimAction action)
+{
+    int events = Sim_Step(&tree->scratch, action);
+
+    play->moves++;
+    if ((events & SIM_EVENT_ATE) && (play->mealValue == 0.0f))
+    {
+        play->mealValue = play->discount;
+    }
+    play->discount *= MCTS_MEAL_DISCOUNT;
+}
+
+/*
+ * Score a finished playout in [0, 1]
+ * A snake that survives to the horizon earns at least half, plus up to
+ * half for food, the sooner the better. A death earns a share of the
+ * lower half for how long it was put off, and no credit for food on the
+ * way, so a meal is never worth dying for.
+ *
+ * @param agent - Agent holding the horizon
+ * @param tree - Tree whose scratch game was played
+ * @param play - Playout progress
+ * @return Value of the playout
+ */
+static float Mcts_GetPlayValue(const MctsAgent* agent, const MctsTree* tree, const MctsPlay* play)
+{
+    if (tree->scratch.isDead)
+    {
+        int survived = (play->moves - 1 < agent->horizon) ? play->moves - 1 : agent->horizon;
+        return 0.5f * (float)survived / (float)agent->horizon;
+    }
+
+    return 0.5f + 0.5f * play->mealValue;
+}
+
+// ============================================================================
+// TREE SEARCH
+// ============================================================================
+
+/*
+ * Pick the child to descend into: an unvisited child first, otherwise
+ * the best UCB1 score
+ *
+ * @param tree - Tree holding the node
+ * @param node - Expanded node
+ * @return Index of the chosen child
+ */
+static uint32_t Mcts_SelectChild(const MctsTree* tree, const MctsNode* node)
+{
+    float logVisits = logf((float)node->visits);
+    uint32_t best = node->firstChild;
+    float bestScore = -1.0f;
+
+    for (uint32_t i = node->firstChild; i < node->firstChild + node->childCount; i++)
+    {
+        const MctsNode* child = &tree->nodes[i];
+        if (child->visits == 0)
+        {
+            return i;
+        }
+
+        float visits = (float)child->visits;
+        float score = child->valueSum / visits + MCTS_EXPLORATION * sqrtf(logVisits / visits);
+        if (score > bestScore)
+        {
+            best = i;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Give a leaf one child per move
+ *
+ * @param tree - Tree holding the node
+ * @param index - Leaf to expand
+ * @param snake - Snake in the leaf's position
+ * @return true if expanded, false if the node pool is full
+ */
+static bool Mcts_Expand(MctsTree* tree, uint32_t index, const Snake* snake)
+{
+    if (tree->nodeCount + MCTS_MOVES > MCTS_TREE_NODES)
+    {
+        return false;
+    }
+
+    SimAction moves[MCTS_MOVES];
+    Mcts_GetMoves(snake, moves);
+
+    tree->nodes[index].firstChild = (uint32_t)tree->nodeCount;
+    tree->nodes[index].childCount = MCTS_MOVES;
+    for (int i = 0; i < MCTS_MOVES; i++)
+    {
+        MctsNode* child = &tree->nodes[tree->nodeCount++];
+        memset(child, 0, sizeof(MctsNode));
+        child->action = (uint8_t)moves[i];
+    }
+
+    return true;
+}
+
+/*
+ * Run one playout: select, expand, play on and back the value up
+ *
+ * @param agent - Agent holding the live game
+ * @param tree - Tree to grow
+ */
+static void Mcts_RunPlayout(const MctsAgent* agent, MctsTree* tree)
+{
+    SimState* sim = &tree->scratch;
+    uint32_t path[MCTS_MAX_DEPTH + 1];
+    int depth = 0;
+    MctsPlay play = { 0, 1.0f, 0.0f };
+
+    sim->rng.state = ((uint64_t)Rng_Next(&tree->rng) << 32) | Rng_Next(&tree->rng);
+
+    // Selection
+    uint32_t index = 0;
+    path[0] = 0;
+    while ((tree->nodes[index].childCount != 0) && !sim->isDead)
+    {
+        index = Mcts_SelectChild(tree, &tree->nodes[index]);
+        Mcts_Step(tree, &play, (SimAction)tree->nodes[index].action);
+        path[++depth] = index;
+    }
+
+    // Expansion: straight on is tried first, the turns on later visits
+    if (!sim->isDead && (depth < MCTS_MAX_DEPTH) && Mcts_Expand(tree, index, &sim->snake))
+    {
+        index = tree->nodes[index].firstChild;
+        Mcts_Step(tree, &play, (SimAction)tree->nodes[index].action);
+        path[++depth] = index;
+    }
+
+    // Simulation
+    while (!sim->isDead && (play.moves < agent->horizon))
+    {
+        Mcts_Step(tree, &play, Mcts_ChoosePlayoutMove(agent, tree));
+    }
+
+    // Backpropagation
+    float value = Mcts_GetPlayValue(agent, tree, &play);
+    for (int i = 0; i <= depth; i++)
+    {
+        tree->nodes[path[i]].visits++;
+        tree->nodes[path[i]].valueSum += value;
+    }
+
+    // Back to the live position for the next playout
+    if (!Sim_Rewind(sim, 0))
+    {
+        Sim_Copy(sim, agent->root);
+    }
+
+    tree->playoutCount++;
+}
+
+/*
+ * Grow trees from scratch until the decision's deadline
+ * Runs on the pool's workers, one tree per item
+ *
+ * @param context - MctsAgent being decided for
+ * @param begin - First tree
+ * @param end - One past the last tree
+ */
+static void Mcts_SearchTask(void* context, int begin, int end)
+{
+    const MctsAgent* agent = context;
+
+    for (int i = begin; i < end; i++)
+    {
+        MctsTree* tree = agent->trees[i];
+
+        Rng_Seed(&tree->rng, agent->root->seed + agent->decisionCount, (uint64_t)i);
+        memset(&tree->nodes[0], 0, sizeof(MctsNode));
+        tree->nodeCount = 1;
+        tree->playoutCount = 0;
+
+        Sim_Copy(&tree->scratch, agent->root);
+        tree->scratch.isProfiled = false;
+
+        do
+        {
+            for (int playout = 0; playout < MCTS_CHECK_INTERVAL; playout++)
+            {
+                Mcts_RunPlayout(agent, tree);
+            }
+        } while (Mcts_NowNs() < agent->deadlineNs);
+    }
+}
+
+// ============================================================================
+// CREATION
+// ============================================================================
+
+/*
+ * Set up a tree search player for the current board size
+ * Each tree takes a node pool (MCTS_TREE_NODES nodes, 1 MB), a scratch
+ * game and a journal long enough for one playout from the arena; nothing
+ * is allocated while deciding.
+ *
+ * @param agent - Agent to create
+ * @param arena - Arena to allocate from
+ * @param budgetMicroseconds - Search time per move
+ * @param pool - Pool to grow one tree per worker on, or NULL for a
+ *               single tree on the calling thread
+ * @return true on success, false if memory could not be allocated
+ */
+bool Mcts_Create(MctsAgent* agent, Arena* arena, int budgetMicroseconds, ThreadPool* pool)
+{
+    assert(agent != NULL);
+    assert(arena != NULL);
+    assert(budgetMicroseconds > 0);
+
+    memset(agent, 0, sizeof(MctsAgent));
+    agent->pool = pool;
+    agent->treeCount = (pool != NULL) ? ThreadPool_GetThreadCount(pool) : 1;
+    agent->budgetMicroseconds = budgetMicroseconds;
+    agent->columns = Utils_GetGridColumns();
+    agent->rows = Utils_GetGridRows();
+    agent->horizon = agent->columns + agent->rows;
+    if (agent->horizon < MCTS_MIN_HORIZON)
+    {
+        agent->horizon = MCTS_MIN_HORIZON;
+    }
+
+    agent->trees = Arena_Allocate(arena, (size_t)agent->treeCount * sizeof(MctsTree*),
+                                  sizeof(MctsTree*));
+    if (agent->trees == NULL)
+    {
+        return false;
+    }
+
+    // Trees start on their own cache lines so workers do not share them
+    size_t treeSize = (sizeof(MctsTree) + MCTS_CACHE_LINE - 1) / MCTS_CACHE_LINE * MCTS_CACHE_LINE;
+    for (int i = 0; i < agent->treeCount; i++)
+    {
+        MctsTree* tree = Arena_Allocate(arena, treeSize, MCTS_CACHE_LINE);
+        if (tree == NULL)
+        {
+            return false;
+        }
+
+        // A playout is at most the tree depth plus one expansion, or the horizon
+        tree->nodes = Arena_Allocate(arena, MCTS_TREE_NODES * sizeof(MctsNode), MCTS_CACHE_LINE);
+        if ((tree->nodes == NULL) || !Sim_Create(&tree->scratch, arena) ||
+            !Sim_CreateJournal(&tree->journal, MCTS_MAX_DEPTH + 1 + agent->horizon, arena))
+        {
+            return false;
+        }
+        Sim_AttachJournal(&tree->scratch, &tree->journal);
+
+        agent->trees[i] = tree;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// DECISIONS
+// ============================================================================
+
+/*
+ * Search for the next move of a game within the time budget
+ *
+ * @param agent - Agent created for the game's board size
+ * @param sim - Game about to be stepped; only read
+ * @return Action to pass to Sim_Step
+ */
+SimAction Mcts_Decide(MctsAgent* agent, const SimState* sim)
+{
+    assert(agent != NULL);
+    assert(sim != NULL);
+    assert(sim->cellCount == agent->trees[0]->scratch.cellCount);
+
+    if (sim->isDead)
+    {
+        return SIM_ACTION_NONE;
+    }
+
+    agent->root = sim;
+    agent->decisionCount++;
+    agent->deadlineNs = Mcts_NowNs() + (uint64_t)agent->budgetMicroseconds * 1000u;
+
+    if (agent->pool != NULL)
+    {
+        ThreadPool_ParallelFor(agent->pool, agent->treeCount, 1, Mcts_SearchTask, agent);
+    }
+    else
+    {
+        Mcts_SearchTask(agent, 0, agent->treeCount);
+    }
+
+    // The trees vote with the visit counts of their first moves
+    uint32_t visits[SIM_ACTION_RIGHT + 1] = { 0 };
+    agent->lastPlayoutCount = 0;
+    for (int i = 0; i < agent->treeCount; i++)
+    {
+        const MctsTree* tree = agent->trees[i];
+        const MctsNode* root = &tree->nodes[0];
+
+        agent->lastPlayoutCount += tree->playoutCount;
+        for (uint32_t child = root->firstChild; child < root->firstChild + root->childCount; child++)
+        {
+            visits[tree->nodes[child].action] += tree->nodes[child].visits;
+        }
+    }
+
+    SimAction best = SIM_ACTION_NONE;
+    for (int action = SIM_ACTION_NONE; action <= SIM_ACTION_RIGHT; action++)
+    {
+        if (visits[action] > visits[best])
+        {
+            best = (SimAction)action;
+        }
+    }
+
+    agent->root = NULL;
+    return best;
+}
+
+/*
+ * Controller callback that hands the decision to the agent in context
+ */
+static SimAction Mcts_DecideController(Controller* controller, const SimState* sim)
+{
+    return Mcts_Decide(controller->context, sim);
+}
+
+/*
+ * Make a controller play with a tree search agent
+ *
+ * @param controller - Controller to initialize
+ * @param agent - Agent created with Mcts_Create; must outlive the controller
+ */
+void Mcts_AttachController(Controller* controller, MctsAgent* agent)
+{
+    assert(agent != NULL);
+
+    Controller_Initialize(controller, Mcts_DecideController, agent);
+}
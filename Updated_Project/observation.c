@@ -0,0 +1,607 @@
+/*
+ * observation.c
+ *
+ * Observation encoder module
+ * Turns a batch's per-game code planes into [N, C, H, W] training tensors
+ * (head, body-with-age and food planes, see ObservationChannel). Every
+ * output cell depends only on the same cell of the code plane and the
+ * cellSlot map, so the encoder is a straight pass over memory with no
+ * segment walking, and x86 builds carry SSE2 and AVX2 kernels chosen at
+ * runtime from the CPU's feature flags. The scalar kernel is the
+ * reference: the vector kernels perform the same float operations in the
+ * same order, so all kernels produce identical bytes.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define OBS_HAVE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#define OBS_CHUNK_GAMES 16  // Games per thread pool chunk
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/*
+ * Everything a kernel needs to encode one game
+ * A body cell's age is ringHead - cellSlot (mod cellCount) and its plane
+ * value is (length - age) * bodyScale; bodyScale is 1 / length for F32
+ * and 255 / length for U8
+ */
+typedef struct {
+    const uint8_t* codes;
+    const uint16_t* slots;
+    int cellCount;
+    int ringHead;
+    int length;
+    float bodyScale;
+} ObservationSource;
+
+/*
+ * Encodes one game into its OBS_CHANNEL_COUNT consecutive planes
+ */
+typedef void (*ObservationEncodeFunc)(const ObservationSource* source, void* planes);
+
+/*
+ * Work shared by the chunks of a parallel encode
+ */
+typedef struct {
+    const SnakeBatch* batch;
+    unsigned char* out;
+    ObservationFormat format;
+    ObservationEncodeFunc encode;
+} ObservationJob;
+
+static ObservationKernel activeKernel = OBS_KERNEL_COUNT;  // Chosen on first use
+
+static const char* const kernelNames[OBS_KERNEL_COUNT] = {
+    "scalar",
+    "sse2",
+    "avx2"
+};
+
+// ============================================================================
+// SCALAR KERNELS
+// ============================================================================
+
+/*
+ * Encode cells [begin, end) of one game as uint8 planes
+ * Also finishes the cells left over by the vector kernels
+ *
+ * @param source - Game to encode
+ * @param planes - Head plane; body and food planes follow
+ * @param begin - First cell
+ * @param end - One past the last cell
+ */
+static void Observation_EncodeRangeU8(const ObservationSource* source, uint8_t* planes,
+                                      int begin, int end)
+{
+    int cellCount = source->cellCount;
+    uint8_t* head = planes;
+    uint8_t* body = planes + cellCount;
+    uint8_t* food = planes + 2 * cellCount;
+
+    for (int cell = begin; cell < end; cell++)
+    {
+        int code = source->codes[cell];
+        int age = source->ringHead - source->slots[cell];
+        if (age < 0) age += cellCount;
+
+        float life = (float)(source->length - age) * source->bodyScale + 0.5f;
+
+        head[cell] = (code == OBS_HEAD) ? 255 : 0;
+        body[cell] = (code == OBS_BODY) ? (uint8_t)(int)life : 0;
+        food[cell] = (code == OBS_FOOD) ? 255 : 0;
+    }
+}
+
+/*
+ * Encode cells [begin, end) of one game as float planes
+ *
+ * @param source - Game to encode
+ * @param planes - Head plane; body and food planes follow
+ * @param begin - First cell
+ * @param end - One past the last cell
+ */
+static void Observation_EncodeRangeF32(const ObservationSource* source, float* planes,
+                                       int begin, int end)
+{
+    int cellCount = source->cellCount;
+    float* head = planes;
+    float* body = planes + cellCount;
+    float* food = planes + 2 * cellCount;
+
+    for (int cell = begin; cell < end; cell++)
+    {
+        int code = source->codes[cell];
+        int age = source->ringHead - source->slots[cell];
+        if (age < 0) age += cellCount;
+
+        head[cell] = (code == OBS_HEAD) ? 1.0f : 0.0f;
+        body[cell] = (code == OBS_BODY) ? (float)(source->length - age) * source->bodyScale : 0.0f;
+        food[cell] = (code == OBS_FOOD) ? 1.0f : 0.0f;
+    }
+}
+
+static void Observation_EncodeScalarU8(const ObservationSource* source, void* planes)
+{
+    Observation_EncodeRangeU8(source, planes, 0, source->cellCount);
+}
+
+static void Observation_EncodeScalarF32(const ObservationSource* source, void* planes)
+{
+    Observation_EncodeRangeF32(source, planes, 0, source->cellCount);
+}
+
+#ifdef OBS_HAVE_X86_KERNELS
+
+// ============================================================================
+// SSE2 KERNELS
+// ============================================================================
+
+/*
+ * Body plane values for four cells, before masking
+ * age = ringHead - slot, wrapped into [0, cellCount)
+ *
+ * @param slots - Four cellSlot entries as int32
+ * @param ringHead - Broadcast ring head
+ * @param cellCount - Broadcast cell count
+ * @param length - Broadcast snake length
+ * @param scale - Broadcast bodyScale
+ * @return (length - age) * scale
+ */
+__attribute__((target("sse2")))
+static __m128 Observation_LifeSse2(__m128i slots, __m128i ringHead, __m128i cellCount,
+                                   __m128i length, __m128 scale)
+{
+    __m128i age = _mm_sub_epi32(ringHead, slots);
+    age = _mm_add_epi32(age, _mm_and_si128(_mm_srai_epi32(age, 31), cellCount));
+
+    return _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(length, age)), scale);
+}
+
+/*
+ * Encode one game as uint8 planes, 16 cells per iteration
+ */
+__attribute__((target("sse2")))
+static void Observation_EncodeSse2U8(const ObservationSource* source, void* planes)
+{
+    int cellCount = source->cellCount;
+    uint8_t* head = planes;
+    uint8_t* body = head + cellCount;
+    uint8_t* food = head + 2 * cellCount;
+
+    const __m128i headCode = _mm_set1_epi8(OBS_HEAD);
+    const __m128i bodyCode = _mm_set1_epi8(OBS_BODY);
+    const __m128i foodCode = _mm_set1_epi8(OBS_FOOD);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ringHead = _mm_set1_epi32(source->ringHead);
+    const __m128i cells = _mm_set1_epi32(cellCount);
+    const __m128i length = _mm_set1_epi32(source->length);
+    const __m128 scale = _mm_set1_ps(source->bodyScale);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    int cell = 0;
+    for (; cell + 16 <= cellCount; cell += 16)
+    {
+        __m128i codes = _mm_loadu_si128((const __m128i*)(source->codes + cell));
+        __m128i slotsLow = _mm_loadu_si128((const __m128i*)(source->slots + cell));
+        __m128i slotsHigh = _mm_loadu_si128((const __m128i*)(source->slots + cell + 8));
+
+        __m128i life[4];
+        __m128i slots[4] = {
+            _mm_unpacklo_epi16(slotsLow, zero), _mm_unpackhi_epi16(slotsLow, zero),
+            _mm_unpacklo_epi16(slotsHigh, zero), _mm_unpackhi_epi16(slotsHigh, zero)
+        };
+        for (int i = 0; i < 4; i++)
+        {
+            __m128 value = Observation_LifeSse2(slots[i], ringHead, cells, length, scale);
+            life[i] = _mm_cvttps_epi32(_mm_add_ps(value, half));
+        }
+
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(life[0], life[1]),
+                                         _mm_packs_epi32(life[2], life[3]));
+
+        _mm_storeu_si128((__m128i*)(head + cell), _mm_cmpeq_epi8(codes, headCode));
+        _mm_storeu_si128((__m128i*)(body + cell),
+                         _mm_and_si128(bytes, _mm_cmpeq_epi8(codes, bodyCode)));
+        _mm_storeu_si128((__m128i*)(food + cell), _mm_cmpeq_epi8(codes, foodCode));
+    }
+
+    Observation_EncodeRangeU8(source, planes, cell, cellCount);
+}
+
+/*
+ * Encode one game as float planes, 16 cells per iteration
+ */
+__attribute__((target("sse2")))
+static void Observation_EncodeSse2F32(const ObservationSource* source, void* planes)
+{
+    int cellCount = source->cellCount;
+    float* head = planes;
+    float* body = head + cellCount;
+    float* food = head + 2 * cellCount;
+
+    const __m128i headCode = _mm_set1_epi8(OBS_HEAD);
+    const __m128i bodyCode = _mm_set1_epi8(OBS_BODY);
+    const __m128i foodCode = _mm_set1_epi8(OBS_FOOD);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ringHead = _mm_set1_epi32(source->ringHead);
+    const __m128i cells = _mm_set1_epi32(cellCount);
+    const __m128i length = _mm_set1_epi32(source->length);
+    const __m128 scale = _mm_set1_ps(source->bodyScale);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    int cell = 0;
+    for (; cell + 16 <= cellCount; cell += 16)
+    {
+        __m128i codes = _mm_loadu_si128((const __m128i*)(source->codes + cell));
+        __m128i slotsLow = _mm_loadu_si128((const __m128i*)(source->slots + cell));
+        __m128i slotsHigh = _mm_loadu_si128((const __m128i*)(source->slots + cell + 8));
+
+        // Byte masks widened to one 32-bit mask per cell
+        __m128i masks[3] = {
+            _mm_cmpeq_epi8(codes, headCode),
+            _mm_cmpeq_epi8(codes, bodyCode),
+            _mm_cmpeq_epi8(codes, foodCode)
+        };
+        __m128i wide[3][4];
+        for (int plane = 0; plane < 3; plane++)
+        {
+            __m128i low = _mm_unpacklo_epi8(masks[plane], masks[plane]);
+            __m128i high = _mm_unpackhi_epi8(masks[plane], masks[plane]);
+            wide[plane][0] = _mm_unpacklo_epi16(low, low);
+            wide[plane][1] = _mm_unpackhi_epi16(low, low);
+            wide[plane][2] = _mm_unpacklo_epi16(high, high);
+            wide[plane][3] = _mm_unpackhi_epi16(high, high);
+        }
+
+        __m128i slots[4] = {
+            _mm_unpacklo_epi16(slotsLow, zero), _mm_unpackhi_epi16(slotsLow, zero),
+            _mm_unpacklo_epi16(slotsHigh, zero), _mm_unpackhi_epi16(slotsHigh, zero)
+        };
+        for (int i = 0; i < 4; i++)
+        {
+            __m128 value = Observation_LifeSse2(slots[i], ringHead, cells, length, scale);
+            int offset = cell + 4 * i;
+
+            _mm_storeu_ps(head + offset, _mm_and_ps(_mm_castsi128_ps(wide[0][i]), one));
+            _mm_storeu_ps(body + offset, _mm_and_ps(_mm_castsi128_ps(wide[1][i]), value));
+            _mm_storeu_ps(food + offset, _mm_and_ps(_mm_castsi128_ps(wide[2][i]), one));
+        }
+    }
+
+    Observation_EncodeRangeF32(source, planes, cell, cellCount);
+}
+
+// ============================================================================
+// AVX2 KERNELS
+// ============================================================================
+
+/*
+ * Body plane values for eight cells, before masking
+ *
+ * @param slots - Eight cellSlot entries
+ * @param ringHead - Broadcast ring head
+ * @param cellCount - Broadcast cell count
+ * @param length - Broadcast snake length
+ * @param scale - Broadcast bodyScale
+ * @return (length - age) * scale
+ */
+__attribute__((target("avx2")))
+static __m256 Observation_LifeAvx2(const uint16_t* slots, __m256i ringHead, __m256i cellCount,
+                                   __m256i length, __m256 scale)
+{
+    __m256i slot = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)slots));
+    __m256i age = _mm256_sub_epi32(ringHead, slot);
+    age = _mm256_add_epi32(age, _mm256_and_si256(_mm256_srai_epi32(age, 31), cellCount));
+
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(length, age)), scale);
+}
+
+/*
+ * Encode one game as uint8 planes, 32 cells per iteration
+ */
+__attribute__((target("avx2")))
+static void Observation_EncodeAvx2U8(const ObservationSource* source, void* planes)
+{
+    int cellCount = source->cellCount;
+    uint8_t* head = planes;
+    uint8_t* body = head + cellCount;
+    uint8_t* food = head + 2 * cellCount;
+
+    const __m256i headCode = _mm256_set1_epi8(OBS_HEAD);
+    const __m256i bodyCode = _mm256_set1_epi8(OBS_BODY);
+    const __m256i foodCode = _mm256_set1_epi8(OBS_FOOD);
+    const __m256i ringHead = _mm256_set1_epi32(source->ringHead);
+    const __m256i cells = _mm256_set1_epi32(cellCount);
+    const __m256i length = _mm256_set1_epi32(source->length);
+    const __m256 scale = _mm256_set1_ps(source->bodyScale);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    // Packing works within 128-bit lanes; this puts the dwords back in order
+    const __m256i unpackOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    int cell = 0;
+    for (; cell + 32 <= cellCount; cell += 32)
+    {
+        __m256i codes = _mm256_loadu_si256((const __m256i*)(source->codes + cell));
+
+        __m256i life[4];
+        for (int i = 0; i < 4; i++)
+        {
+            __m256 value = Observation_LifeAvx2(source->slots + cell + 8 * i,
+                                                ringHead, cells, length, scale);
+            life[i] = _mm256_cvttps_epi32(_mm256_add_ps(value, half));
+        }
+
+        __m256i bytes = _mm256_packus_epi16(_mm256_packs_epi32(life[0], life[1]),
+                                            _mm256_packs_epi32(life[2], life[3]));
+        bytes = _mm256_permutevar8x32_epi32(bytes, unpackOrder);
+
+        _mm256_storeu_si256((__m256i*)(head + cell), _mm256_cmpeq_epi8(codes, headCode));
+        _mm256_storeu_si256((__m256i*)(body + cell),
+                            _mm256_and_si256(bytes, _mm256_cmpeq_epi8(codes, bodyCode)));
+        _mm256_storeu_si256((__m256i*)(food + cell), _mm256_cmpeq_epi8(codes, foodCode));
+    }
+
+    // The scalar tail and the caller use legacy SSE encodings
+    _mm256_zeroupper();
+    Observation_EncodeRangeU8(source, planes, cell, cellCount);
+}
+
+/*
+ * Encode one game as float planes, 8 cells per iteration
+ */
+__attribute__((target("avx2")))
+static void Observation_EncodeAvx2F32(const ObservationSource* source, void* planes)
+{
+    int cellCount = source->cellCount;
+    float* head = planes;
+    float* body = head + cellCount;
+    float* food = head + 2 * cellCount;
+
+    const __m256i headCode = _mm256_set1_epi32(OBS_HEAD);
+    const __m256i bodyCode = _mm256_set1_epi32(OBS_BODY);
+    const __m256i foodCode = _mm256_set1_epi32(OBS_FOOD);
+    const __m256i ringHead = _mm256_set1_epi32(source->ringHead);
+    const __m256i cells = _mm256_set1_epi32(cellCount);
+    const __m256i length = _mm256_set1_epi32(source->length);
+    const __m256 scale = _mm256_set1_ps(source->bodyScale);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    int cell = 0;
+    for (; cell + 8 <= cellCount; cell += 8)
+    {
+        __m256i codes = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(source->codes + cell)));
+        __m256 value = Observation_LifeAvx2(source->slots + cell, ringHead, cells, length, scale);
+
+        __m256 isHead = _mm256_castsi256_ps(_mm256_cmpeq_epi32(codes, headCode));
+        __m256 isBody = _mm256_castsi256_ps(_mm256_cmpeq_epi32(codes, bodyCode));
+        __m256 isFood = _mm256_castsi256_ps(_mm256_cmpeq_epi32(codes, foodCode));
+
+        _mm256_storeu_ps(head + cell, _mm256_and_ps(isHead, one));
+        _mm256_storeu_ps(body + cell, _mm256_and_ps(isBody, value));
+        _mm256_storeu_ps(food + cell, _mm256_and_ps(isFood, one));
+    }
+
+    // The scalar tail and the caller use legacy SSE encodings
+    _mm256_zeroupper();
+    Observation_EncodeRangeF32(source, planes, cell, cellCount);
+}
+
+#endif // OBS_HAVE_X86_KERNELS
+
+// ============================================================================
+// KERNEL SELECTION
+// ============================================================================
+
+/*
+ * Look up the encode function of a kernel
+ *
+ * @param kernel - Kernel to use
+ * @param format - Output element type
+ * @return Encode function, or NULL if the kernel is not built in
+ */
+static ObservationEncodeFunc Observation_GetEncodeFunc(ObservationKernel kernel,
+                                                       ObservationFormat format)
+{
+    bool isFloat = (format == OBS_FORMAT_F32);
+
+    switch (kernel)
+    {
+        case OBS_KERNEL_SCALAR:
+            return isFloat ? Observation_EncodeScalarF32 : Observation_EncodeScalarU8;
+#ifdef OBS_HAVE_X86_KERNELS
+        case OBS_KERNEL_SSE2:
+            return isFloat ? Observation_EncodeSse2F32 : Observation_EncodeSse2U8;
+        case OBS_KERNEL_AVX2:
+            return isFloat ? Observation_EncodeAvx2F32 : Observation_EncodeAvx2U8;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/*
+ * Check whether a kernel is built in and the CPU can run it
+ *
+ * @param kernel - Kernel to check
+ * @return true if Observation_SetKernel would accept it
+ */
+bool Observation_IsKernelSupported(ObservationKernel kernel)
+{
+    switch (kernel)
+    {
+        case OBS_KERNEL_SCALAR:
+            return true;
+#ifdef OBS_HAVE_X86_KERNELS
+        case OBS_KERNEL_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case OBS_KERNEL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+/*
+ * Get the kernel the encoder uses
+ * The fastest supported kernel is picked on first use
+ *
+ * @return Active kernel
+ */
+ObservationKernel Observation_GetKernel(void)
+{
+    if (activeKernel == OBS_KERNEL_COUNT)
+    {
+        ObservationKernel best = OBS_KERNEL_COUNT - 1;
+        while (!Observation_IsKernelSupported(best))
+        {
+            best--;
+        }
+
+        activeKernel = best;
+    }
+
+    return activeKernel;
+}
+
+/*
+ * Force a kernel, e.g. to compare kernels in a benchmark
+ * Not safe to call while another thread is encoding
+ *
+ * @param kernel - Kernel to use
+ * @return true on success, false if the kernel is not supported (the
+ *         active kernel is then left unchanged)
+ */
+bool Observation_SetKernel(ObservationKernel kernel)
+{
+    if (!Observation_IsKernelSupported(kernel))
+    {
+        return false;
+    }
+
+    activeKernel = kernel;
+    return true;
+}
+
+/*
+ * Get the display name of a kernel
+ *
+ * @param kernel - Kernel
+ * @return Name such as "avx2"
+ */
+const char* Observation_GetKernelName(ObservationKernel kernel)
+{
+    assert(kernel >= 0 && kernel < OBS_KERNEL_COUNT);
+
+    return kernelNames[kernel];
+}
+
+// ============================================================================
+// BATCH ENCODING
+// ============================================================================
+
+/*
+ * Get the size of an encoded batch
+ *
+ * @param batch - Pointer to batch
+ * @param format - Output element type
+ * @return Bytes needed for gameCount * OBS_CHANNEL_COUNT * rows * columns
+ *         elements
+ */
+size_t Observation_GetBatchSize(const SnakeBatch* batch, ObservationFormat format)
+{
+    assert(batch != NULL);
+
+    size_t elementSize = (format == OBS_FORMAT_F32) ? sizeof(float) : sizeof(uint8_t);
+    return (size_t)batch->gameCount * OBS_CHANNEL_COUNT * batch->cellCount * elementSize;
+}
+
+/*
+ * Encode games [begin, end) of a batch
+ *
+ * @param job - Batch, output and kernel
+ * @param begin - First game
+ * @param end - One past the last game
+ */
+static void Observation_EncodeRange(const ObservationJob* job, int begin, int end)
+{
+    const SnakeBatch* batch = job->batch;
+    bool isFloat = (job->format == OBS_FORMAT_F32);
+    size_t gameBytes = (size_t)OBS_CHANNEL_COUNT * batch->cellCount *
+                       (isFloat ? sizeof(float) : sizeof(uint8_t));
+
+    for (int game = begin; game < end; game++)
+    {
+        size_t base = (size_t)game * batch->cellCount;
+        int length = batch->length[game];
+
+        ObservationSource source = {
+            batch->observations + base,
+            batch->cellSlot + base,
+            batch->cellCount,
+            batch->ringHead[game],
+            length,
+            (isFloat ? 1.0f : 255.0f) / (float)length
+        };
+
+        job->encode(&source, job->out + (size_t)game * gameBytes);
+    }
+}
+
+/*
+ * Thread pool task: encode one chunk of games
+ */
+static void Observation_EncodeTask(void* context, int begin, int end)
+{
+    Observation_EncodeRange(context, begin, end);
+}
+
+/*
+ * Encode every game of a batch into an [N, C, H, W] buffer
+ *
+ * @param batch - Pointer to batch
+ * @param out - Buffer of Observation_GetBatchSize bytes (float aligned
+ *              for OBS_FORMAT_F32)
+ * @param format - Output element type
+ */
+void Observation_EncodeBatch(const SnakeBatch* batch, void* out, ObservationFormat format)
+{
+    assert(batch != NULL);
+    assert(out != NULL);
+
+    ObservationJob job = { batch, out, format,
+                           Observation_GetEncodeFunc(Observation_GetKernel(), format) };
+    Observation_EncodeRange(&job, 0, batch->gameCount);
+}
+
+/*
+ * Encode every game of a batch, splitting games across a thread pool
+ *
+ * @param batch - Pointer to batch
+ * @param out - Buffer of Observation_GetBatchSize bytes
+ * @param format - Output element type
+ * @param pool - Thread pool to run on
+ */
+void Observation_EncodeBatchParallel(const SnakeBatch* batch, void* out, ObservationFormat format,
+                                     ThreadPool* pool)
+{
+    assert(batch != NULL);
+    assert(out != NULL);
+    assert(pool != NULL);
+
+    ObservationJob job = { batch, out, format,
+                           Observation_GetEncodeFunc(Observation_GetKernel(), format) };
+    ThreadPool_ParallelFor(pool, batch->gameCount, OBS_CHUNK_GAMES, Observation_EncodeTask, &job);
+}
@@ -0,0 +1,75 @@
+/*
+ * occupancy.c
+ *
+ * Occupancy bitset module
+ * One bit per grid cell, so asking "is this cell taken?" is a single
+ * bit test instead of a walk over every snake segment
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <string.h>
+
+// ============================================================================
+// BITSET OPERATIONS
+// ============================================================================
+
+/*
+ * Mark every cell as free
+ *
+ * @param bits - Bitset storage with at least (cellCount + 63) / 64 words
+ * @param cellCount - Number of cells covered by the bitset
+ */
+void Occupancy_ClearAll(uint64_t* bits, int cellCount)
+{
+    assert(bits != NULL);
+    assert(cellCount >= 0);
+
+    memset(bits, 0, (size_t)((cellCount + 63) / 64) * sizeof(uint64_t));
+}
+
+/*
+ * Mark a cell as occupied
+ *
+ * @param bits - Bitset storage
+ * @param cell - Linear cell index
+ */
+void Occupancy_Mark(uint64_t* bits, int cell)
+{
+    assert(bits != NULL);
+    assert(cell >= 0);
+
+    bits[cell >> 6] |= (uint64_t)1 << (cell & 63);
+}
+
+/*
+ * Mark a cell as free
+ *
+ * @param bits - Bitset storage
+ * @param cell - Linear cell index
+ */
+void Occupancy_Release(uint64_t* bits, int cell)
+{
+    assert(bits != NULL);
+    assert(cell >= 0);
+
+    bits[cell >> 6] &= ~((uint64_t)1 << (cell & 63));
+}
+
+/*
+ * Check whether a cell is occupied
+ *
+ * @param bits - Bitset storage
+ * @param cell - Linear cell index
+ * @return true if the cell is marked occupied
+ */
+bool Occupancy_IsOccupied(const uint64_t* bits, int cell)
+{
+    assert(bits != NULL);
+    assert(cell >= 0);
+
+    return (bits[cell >> 6] >> (cell & 63)) & 1;
+}
@@ -0,0 +1,507 @@
+/*
+ * path.c
+ *
+ * Distance field module
+ * Keeps the number of moves from every cell to the food, walking around
+ * the body, for bots and the on-screen path hint. A move changes two
+ * cells: the tail's old cell opens, which can only shorten distances, and
+ * the new head closes, which can only lengthen them. Each change repairs
+ * just the cells it affects (a dynamic BFS), so a move costs time in
+ * proportion to the distances it changes rather than to the board. A
+ * meal moves the source the same way: the new food cell spreads shorter
+ * distances and the eaten one, closed by the head, lengthens the rest.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <string.h>
+
+#define PATH_FLAG_WALL      0x01    // Body cell
+#define PATH_FLAG_CHECKED   0x02    // Queued while looking for affected cells
+#define PATH_FLAG_AFFECTED  0x04    // Distance being recomputed
+#define PATH_NO_CELL        UINT32_MAX  // End of a bucket
+
+// ============================================================================
+// BOARD HELPERS
+// ============================================================================
+
+/*
+ * Shortest distance over a cell's open neighbors plus one
+ * Cells being recomputed do not count
+ *
+ * @param field - Field to read
+ * @param cell - Cell index
+ * @return Tentative distance of the cell, or PATH_UNREACHABLE
+ */
+static uint32_t Path_GetNeighborDistance(const PathField* field, uint32_t cell)
+{
+    uint32_t neighbors[4];
+    uint32_t best = PATH_UNREACHABLE;
+
+    Utils_GetNeighborCells(field->columns, field->cellCount, cell, neighbors);
+    for (int i = 0; i < 4; i++)
+    {
+        uint32_t distance = field->distance[neighbors[i]];
+        bool isOpen = !(field->flags[neighbors[i]] & (PATH_FLAG_WALL | PATH_FLAG_AFFECTED));
+        if (isOpen && (distance != PATH_UNREACHABLE) && (distance + 1 < best))
+        {
+            best = distance + 1;
+        }
+    }
+
+    return best;
+}
+
+// ============================================================================
+// FIELD UPDATES
+// ============================================================================
+
+/*
+ * Spread shorter distances outward from the cells in queue[0, count)
+ * The queued cells must be in distance order
+ *
+ * @param field - Field to update
+ * @param count - Cells already queued
+ */
+static void Path_Propagate(PathField* field, int count)
+{
+    uint32_t neighbors[4];
+
+    for (int head = 0; head < count; head++)
+    {
+        uint32_t cell = field->queue[head];
+        uint32_t next = field->distance[cell] + 1;
+
+        Utils_GetNeighborCells(field->columns, field->cellCount, cell, neighbors);
+        for (int i = 0; i < 4; i++)
+        {
+            uint32_t neighbor = neighbors[i];
+            if (!(field->flags[neighbor] & PATH_FLAG_WALL) && (next < field->distance[neighbor]))
+            {
+                field->distance[neighbor] = next;
+                field->queue[count++] = neighbor;
+                field->changedCount++;
+            }
+        }
+    }
+}
+
+/*
+ * Open a cell the tail has left; distances can only shrink
+ *
+ * @param field - Field to update
+ * @param cell - Vacated cell
+ */
+static void Path_Open(PathField* field, uint32_t cell)
+{
+    if (!(field->flags[cell] & PATH_FLAG_WALL))
+    {
+        return;
+    }
+
+    field->flags[cell] &= (uint8_t)~PATH_FLAG_WALL;
+    field->distance[cell] = Path_GetNeighborDistance(field, cell);
+    field->changedCount++;
+
+    if (field->distance[cell] != PATH_UNREACHABLE)
+    {
+        field->queue[0] = cell;
+        Path_Propagate(field, 1);
+    }
+}
+
+/*
+ * Lengthen the distances that depended on a cell; distances can only grow
+ * First collects the cells whose every shortest route ran through it,
+ * in distance order, then rebuilds their distances from the unaffected
+ * cells around them, nearest first
+ *
+ * @param field - Field to update
+ * @param cell - Cell that closed or stopped being the food
+ * @param lostDistance - Distance the cell had
+ * @param isOpen - true if the cell stays open (a former food cell), so
+ *                 it is re-settled along with the affected cells
+ */
+static void Path_Raise(PathField* field, uint32_t cell, uint32_t lostDistance, bool isOpen)
+{
+    uint32_t* queue = field->queue;
+    uint8_t* flags = field->flags;
+    uint32_t neighbors[4];
+
+    // Cells one step further out may have routed through the cell; a
+    // cell with no other neighbor one step closer is affected, and so
+    // may be the cells one step beyond it
+    int checkedCount = 0;
+    int affectedCount = 0;
+    if (isOpen)
+    {
+        flags[cell] |= PATH_FLAG_AFFECTED;
+        field->affected[affectedCount++] = cell;
+    }
+
+    Utils_GetNeighborCells(field->columns, field->cellCount, cell, neighbors);
+    for (int i = 0; i < 4; i++)
+    {
+        uint32_t neighbor = neighbors[i];
+        if (!(flags[neighbor] & (PATH_FLAG_WALL | PATH_FLAG_CHECKED)) &&
+            (field->distance[neighbor] == lostDistance + 1))
+        {
+            flags[neighbor] |= PATH_FLAG_CHECKED;
+            queue[checkedCount++] = neighbor;
+        }
+    }
+
+    for (int head = 0; head < checkedCount; head++)
+    {
+        uint32_t candidate = queue[head];
+        uint32_t distance = field->distance[candidate];
+        if (Path_GetNeighborDistance(field, candidate) == distance)
+        {
+            continue;
+        }
+
+        flags[candidate] |= PATH_FLAG_AFFECTED;
+        field->affected[affectedCount++] = candidate;
+
+        Utils_GetNeighborCells(field->columns, field->cellCount, candidate, neighbors);
+        for (int i = 0; i < 4; i++)
+        {
+            uint32_t neighbor = neighbors[i];
+            if (!(flags[neighbor] & (PATH_FLAG_WALL | PATH_FLAG_CHECKED)) &&
+                (field->distance[neighbor] == distance + 1))
+            {
+                flags[neighbor] |= PATH_FLAG_CHECKED;
+                queue[checkedCount++] = neighbor;
+            }
+        }
+    }
+
+    for (int i = 0; i < checkedCount; i++)
+    {
+        flags[queue[i]] &= (uint8_t)~PATH_FLAG_CHECKED;
+    }
+
+    if (affectedCount == 0)
+    {
+        return;
+    }
+
+    // Tentative distances from the unaffected rim, bucketed by distance
+    uint32_t* bucketHead = field->bucketHead;
+    uint32_t lowest = PATH_UNREACHABLE;
+    uint32_t highest = 0;
+    for (int i = 0; i < affectedCount; i++)
+    {
+        uint32_t affected = field->affected[i];
+        uint32_t distance = Path_GetNeighborDistance(field, affected);
+
+        field->distance[affected] = distance;
+        if (distance == PATH_UNREACHABLE)
+        {
+            continue;  // Cut off from the food unless a neighbor settles
+        }
+
+        field->bucketNext[affected] = bucketHead[distance];
+        bucketHead[distance] = affected;
+        lowest = (distance < lowest) ? distance : lowest;
+        highest = (distance > highest) ? distance : highest;
+    }
+    field->changedCount += affectedCount;
+
+    // Settle cells nearest first: the buckets in distance order, merged with
+    // a BFS queue of the cells reached from settled ones. A cell settled
+    // from the queue is skipped when its bucket comes up; every bucket is
+    // emptied on the way, so they are all empty again for the next repair
+    int queueHead = 0;
+    int queueCount = 0;
+    uint32_t bucket = lowest;
+    while ((queueHead < queueCount) || (bucket <= highest))
+    {
+        if ((bucket <= highest) && (bucketHead[bucket] == PATH_NO_CELL))
+        {
+            bucket++;
+            continue;
+        }
+
+        uint32_t settled;
+        if ((queueHead < queueCount) &&
+            ((bucket > highest) || (field->distance[queue[queueHead]] <= bucket)))
+        {
+            settled = queue[queueHead++];
+        }
+        else
+        {
+            settled = bucketHead[bucket];
+            bucketHead[bucket] = field->bucketNext[settled];
+        }
+
+        if (!(flags[settled] & PATH_FLAG_AFFECTED))
+        {
+            continue;
+        }
+
+        flags[settled] &= (uint8_t)~PATH_FLAG_AFFECTED;
+        Utils_GetNeighborCells(field->columns, field->cellCount, settled, neighbors);
+        for (int i = 0; i < 4; i++)
+        {
+            uint32_t neighbor = neighbors[i];
+            if ((flags[neighbor] & PATH_FLAG_AFFECTED) &&
+                (field->distance[settled] + 1 < field->distance[neighbor]))
+            {
+                field->distance[neighbor] = field->distance[settled] + 1;
+                queue[queueCount++] = neighbor;
+            }
+        }
+    }
+
+    for (int i = 0; i < affectedCount; i++)
+    {
+        flags[field->affected[i]] &= (uint8_t)~PATH_FLAG_AFFECTED;
+    }
+}
+
+/*
+ * Close a cell the head has entered
+ *
+ * @param field - Field to update
+ * @param cell - Cell that became part of the body
+ */
+static void Path_Close(PathField* field, uint32_t cell)
+{
+    if (field->flags[cell] & PATH_FLAG_WALL)
+    {
+        return;
+    }
+
+    uint32_t closedDistance = field->distance[cell];
+    field->flags[cell] |= PATH_FLAG_WALL;
+    field->distance[cell] = PATH_UNREACHABLE;
+    field->changedCount++;
+
+    if (closedDistance != PATH_UNREACHABLE)
+    {
+        Path_Raise(field, cell, closedDistance, false);
+    }
+}
+
+/*
+ * Make a new food cell a source; distances can only shrink
+ *
+ * @param field - Field to update
+ * @param cell - Open cell the food appeared on
+ */
+static void Path_AddFood(PathField* field, uint32_t cell)
+{
+    if ((field->flags[cell] & PATH_FLAG_WALL) || (field->distance[cell] == 0))
+    {
+        return;
+    }
+
+    field->distance[cell] = 0;
+    field->changedCount++;
+    field->queue[0] = cell;
+    Path_Propagate(field, 1);
+}
+
+/*
+ * Stop a cell being a source once its food is gone; a cell the head
+ * has eaten the food on is already closed
+ *
+ * @param field - Field to update
+ * @param cell - Former food cell
+ */
+static void Path_RemoveFood(PathField* field, uint32_t cell)
+{
+    if ((field->flags[cell] & PATH_FLAG_WALL) || (field->distance[cell] != 0))
+    {
+        return;
+    }
+
+    Path_Raise(field, cell, 0, true);
+}
+
+/*
+ * Rebuild the whole field with one BFS from the food
+ *
+ * @param field - Field to rebuild
+ * @param sim - Game to take the body and the food from
+ */
+static void Path_Rebuild(PathField* field, const SimState* sim)
+{
+    const Snake* snake = &sim->snake;
+
+    memset(field->flags, 0, (size_t)field->cellCount);
+    for (int i = 0; i < field->cellCount; i++)
+    {
+        field->distance[i] = PATH_UNREACHABLE;
+    }
+
+    for (int segment = 0; segment < (int)snake->length; segment++)
+    {
+        field->flags[Snake_GetSegmentCell(snake, segment)] = PATH_FLAG_WALL;
+    }
+
+    field->changedCount = field->cellCount;
+    if (sim->food.active)
+    {
+        field->distance[sim->food.cell] = 0;
+        field->queue[0] = sim->food.cell;
+        Path_Propagate(field, 1);
+    }
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+/*
+ * Take a distance field for the current board size from an arena
+ * Memory grows with the board: 21 bytes per cell. The field is brought
+ * up to date by the first Path_Update.
+ *
+ * @param field - Field to create
+ * @param arena - Arena to allocate from
+ * @return true on success, false if memory could not be allocated
+ */
+bool Path_Create(PathField* field, Arena* arena)
+{
+    assert(field != NULL);
+    assert(arena != NULL);
+
+    memset(field, 0, sizeof(PathField));
+    field->columns = Utils_GetGridColumns();
+    field->rows = Utils_GetGridRows();
+    field->cellCount = Utils_GetCellCount();
+
+    size_t cells = (size_t)field->cellCount;
+    field->distance = Arena_Allocate(arena, cells * sizeof(uint32_t), sizeof(uint32_t));
+    field->queue = Arena_Allocate(arena, cells * sizeof(uint32_t), sizeof(uint32_t));
+    field->affected = Arena_Allocate(arena, cells * sizeof(uint32_t), sizeof(uint32_t));
+    field->flags = Arena_Allocate(arena, cells, 1);
+    field->bucketHead = Arena_Allocate(arena, cells * sizeof(uint32_t), sizeof(uint32_t));
+    field->bucketNext = Arena_Allocate(arena, cells * sizeof(uint32_t), sizeof(uint32_t));
+    if ((field->distance == NULL) || (field->queue == NULL) || (field->affected == NULL) ||
+        (field->flags == NULL) || (field->bucketHead == NULL) || (field->bucketNext == NULL))
+    {
+        return false;
+    }
+
+    memset(field->bucketHead, 0xFF, cells * sizeof(uint32_t));
+    return true;
+}
+
+/*
+ * Bring the field up to date with a game
+ * One move after the last update only the cells that changed are
+ * repaired: the vacated tail cell (none when the snake grew), the new
+ * head and, after a meal, the food cell that replaced the eaten one.
+ * Anything else (a new game, a restored snapshot or skipped moves)
+ * rebuilds the field. Calling it again without a move costs nothing.
+ *
+ * @param field - Field created for the game's board size
+ * @param sim - Game to follow
+ */
+void Path_Update(PathField* field, const SimState* sim)
+{
+    assert(field != NULL);
+    assert(sim != NULL);
+    assert(sim->cellCount == field->cellCount);
+
+    const Snake* snake = &sim->snake;
+    uint32_t head = snake->body[snake->headIndex];
+    bool isSameGame = field->isCurrent && (sim->seed == field->seed);
+    bool isSameFood = (sim->food.active == field->hasFood) &&
+                      (!sim->food.active || (sim->food.cell == field->foodCell));
+
+    if (isSameGame && isSameFood && (sim->tickCount == field->tickCount) &&
+        (head == field->headCell) && (snake->length == field->length))
+    {
+        return;
+    }
+
+    field->changedCount = 0;
+    if (isSameGame && (sim->tickCount == field->tickCount + 1) &&
+        ((uint32_t)Snake_GetSegmentCell(snake, 1) == field->headCell) &&
+        ((snake->length == field->length) || (snake->length == field->length + 1)))
+    {
+        // The tail leaves before the head arrives, so the head may take its
+        // cell; a snake that grew kept its tail
+        if (snake->length == field->length)
+        {
+            Path_Open(field, (uint32_t)Snake_GetSegmentCell(snake, (int)snake->length));
+        }
+
+        // The new food spreads out before the old one goes, so only the
+        // cells still nearer the old food are re-settled
+        if (!isSameFood && sim->food.active)
+        {
+            Path_AddFood(field, sim->food.cell);
+        }
+        Path_Close(field, head);
+        if (!isSameFood && field->hasFood)
+        {
+            Path_RemoveFood(field, field->foodCell);
+        }
+    }
+    else
+    {
+        Path_Rebuild(field, sim);
+    }
+
+    field->isCurrent = true;
+    field->seed = sim->seed;
+    field->tickCount = sim->tickCount;
+    field->headCell = head;
+    field->length = snake->length;
+    field->hasFood = sim->food.active;
+    field->foodCell = sim->food.cell;
+}
+
+/*
+ * Moves from a cell to the food, walking around the body as it is now
+ *
+ * @param field - Field brought up to date by Path_Update
+ * @param cell - Cell index
+ * @return Distance in moves, or PATH_UNREACHABLE for body cells and
+ *         cells with no way to the food
+ */
+uint32_t Path_DistanceToFood(const PathField* field, int cell)
+{
+    assert(field != NULL);
+    assert(cell >= 0 && cell < field->cellCount);
+
+    return field->distance[cell];
+}
+
+/*
+ * Next cell on a shortest way from a cell to the food
+ * Works from body cells too, so it can start at the head
+ *
+ * @param field - Field brought up to date by Path_Update
+ * @param cell - Cell index
+ * @return Open neighbor closest to the food, or -1 if none can reach it
+ */
+int Path_GetStep(const PathField* field, int cell)
+{
+    assert(field != NULL);
+    assert(cell >= 0 && cell < field->cellCount);
+
+    uint32_t neighbors[4];
+    uint32_t bestDistance = PATH_UNREACHABLE;
+    int best = -1;
+
+    Utils_GetNeighborCells(field->columns, field->cellCount, (uint32_t)cell, neighbors);
+    for (int i = 0; i < 4; i++)
+    {
+        if (field->distance[neighbors[i]] < bestDistance)
+        {
+            best = (int)neighbors[i];
+            bestDistance = field->distance[neighbors[i]];
+        }
+    }
+
+    return best;
+}
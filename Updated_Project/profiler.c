@@ -0,0 +1,303 @@
+/*
+ * profiler.c
+ *
+ * Built-in frame and tick profiler
+ * Scoped timers add the time spent in each phase during a frame; at the
+ * end of the frame every phase that ran adds that total to a log-scale
+ * histogram, from which p50, p99 and max are read. Fixed memory, no
+ * sorting, and a single clock read per timer edge, so it can stay on in
+ * release builds. Disabled timers cost one branch.
+ *
+ * Timers are meant for the thread running the game loop only.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Buckets below this are one nanosecond wide; above, each power of two
+// is split into this many buckets (about 12% resolution)
+#define PROFILE_SUB_BUCKETS 8
+#define PROFILE_SUB_BITS    3
+
+// ============================================================================
+// PROFILER STATE
+// ============================================================================
+
+/*
+ * Accumulated timings of one phase
+ */
+typedef struct {
+    uint64_t buckets[PROFILE_BUCKETS];
+    uint64_t samples;
+    uint64_t totalNs;
+    uint64_t maxNs;
+    uint64_t frameNs;
+    bool ranThisFrame;
+} ProfilePhaseData;
+
+static bool isProfilerEnabled = false;
+static ProfilePhaseData phaseData[PROFILE_PHASE_COUNT];
+
+static const char* const phaseNames[PROFILE_PHASE_COUNT] = {
+    "input",
+    "tick",
+    "movement",
+    "collision",
+    "food_spawn",
+    "render_board",
+    "render_snake",
+    "render_overlay",
+    "render_present",
+    "frame"
+};
+
+// ============================================================================
+// HISTOGRAM HELPERS
+// ============================================================================
+
+/*
+ * Read a monotonic clock in nanoseconds (never 0)
+ */
+static uint64_t Profiler_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec + 1u;
+}
+
+/*
+ * Map a duration to its histogram bucket
+ */
+static int Profiler_BucketOf(uint64_t ns)
+{
+    if (ns < PROFILE_SUB_BUCKETS)
+    {
+        return (int)ns;
+    }
+
+    int octave = 63 - __builtin_clzll(ns);
+    int sub = (int)((ns >> (octave - PROFILE_SUB_BITS)) & (PROFILE_SUB_BUCKETS - 1));
+    int bucket = (octave - PROFILE_SUB_BITS + 1) * PROFILE_SUB_BUCKETS + sub;
+
+    return (bucket < PROFILE_BUCKETS) ? bucket : PROFILE_BUCKETS - 1;
+}
+
+/*
+ * Middle of the duration range covered by a bucket
+ */
+static double Profiler_BucketMidpoint(int bucket)
+{
+    if (bucket < PROFILE_SUB_BUCKETS)
+    {
+        return (double)bucket;
+    }
+
+    int octave = bucket / PROFILE_SUB_BUCKETS + PROFILE_SUB_BITS - 1;
+    int sub = bucket % PROFILE_SUB_BUCKETS;
+    double width = (double)(1ull << (octave - PROFILE_SUB_BITS));
+
+    return (double)(PROFILE_SUB_BUCKETS + sub) * width + 0.5 * width;
+}
+
+/*
+ * Read a percentile of a phase's samples in nanoseconds
+ */
+static double Profiler_PercentileNs(const ProfilePhaseData* data, double percentile)
+{
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)data->samples + 0.5);
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+    {
+        seen += data->buckets[bucket];
+        if (seen >= rank)
+        {
+            double value = Profiler_BucketMidpoint(bucket);
+            return (value < (double)data->maxNs) ? value : (double)data->maxNs;
+        }
+    }
+
+    return (double)data->maxNs;
+}
+
+// ============================================================================
+// PROFILER CONTROL
+// ============================================================================
+
+/*
+ * Turn the timers on or off; statistics gathered so far are kept
+ *
+ * @param enabled - true to record timings
+ */
+void Profiler_SetEnabled(bool enabled)
+{
+    isProfilerEnabled = enabled;
+}
+
+/*
+ * Check whether the timers are recording
+ *
+ * @return true if enabled
+ */
+bool Profiler_IsEnabled(void)
+{
+    return isProfilerEnabled;
+}
+
+/*
+ * Drop every recorded timing
+ */
+void Profiler_Reset(void)
+{
+    memset(phaseData, 0, sizeof(phaseData));
+}
+
+// ============================================================================
+// TIMERS
+// ============================================================================
+
+/*
+ * Start a scoped timer
+ *
+ * @return Start timestamp to pass to Profiler_End, or 0 when disabled
+ */
+uint64_t Profiler_Begin(void)
+{
+    return isProfilerEnabled ? Profiler_NowNs() : 0;
+}
+
+/*
+ * Stop a scoped timer and add its time to the phase's frame total
+ * The returned timestamp can start the next phase without another
+ * clock read
+ *
+ * @param phase - Phase the time belongs to
+ * @param start - Value returned by Profiler_Begin (or a previous End)
+ * @return End timestamp, or 0 when disabled
+ */
+uint64_t Profiler_End(ProfilePhase phase, uint64_t start)
+{
+    assert(phase >= 0 && phase < PROFILE_PHASE_COUNT);
+
+    if (start == 0)
+    {
+        return 0;
+    }
+
+    uint64_t now = Profiler_NowNs();
+    phaseData[phase].frameNs += now - start;
+    phaseData[phase].ranThisFrame = true;
+
+    return now;
+}
+
+/*
+ * Close the current frame: every phase that ran adds its frame total
+ * to its histogram
+ */
+void Profiler_EndFrame(void)
+{
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        ProfilePhaseData* data = &phaseData[phase];
+        if (!data->ranThisFrame)
+        {
+            continue;
+        }
+
+        data->buckets[Profiler_BucketOf(data->frameNs)]++;
+        data->samples++;
+        data->totalNs += data->frameNs;
+        if (data->frameNs > data->maxNs)
+        {
+            data->maxNs = data->frameNs;
+        }
+
+        data->frameNs = 0;
+        data->ranThisFrame = false;
+    }
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+/*
+ * Get the display name of a phase
+ *
+ * @param phase - Phase to name
+ * @return Static lowercase name
+ */
+const char* Profiler_GetPhaseName(ProfilePhase phase)
+{
+    assert(phase >= 0 && phase < PROFILE_PHASE_COUNT);
+
+    return phaseNames[phase];
+}
+
+/*
+ * Summarize one phase
+ *
+ * @param phase - Phase to summarize
+ * @param stats - Receives the summary (all zero if the phase never ran)
+ */
+void Profiler_GetStats(ProfilePhase phase, ProfileStats* stats)
+{
+    assert(phase >= 0 && phase < PROFILE_PHASE_COUNT);
+    assert(stats != NULL);
+
+    const ProfilePhaseData* data = &phaseData[phase];
+
+    memset(stats, 0, sizeof(*stats));
+    if (data->samples == 0)
+    {
+        return;
+    }
+
+    stats->samples = data->samples;
+    stats->meanMicroseconds = (double)data->totalNs / (double)data->samples / 1000.0;
+    stats->p50Microseconds = Profiler_PercentileNs(data, 50.0) / 1000.0;
+    stats->p99Microseconds = Profiler_PercentileNs(data, 99.0) / 1000.0;
+    stats->maxMicroseconds = (double)data->maxNs / 1000.0;
+}
+
+/*
+ * Write a summary of every phase as CSV
+ * Columns: phase, samples, mean_us, p50_us, p99_us, max_us
+ *
+ * @param path - File to write
+ * @return true if the file was written, false otherwise
+ */
+bool Profiler_WriteCsv(const char* path)
+{
+    assert(path != NULL);
+
+    FILE* file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    fprintf(file, "phase,samples,mean_us,p50_us,p99_us,max_us\n");
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        ProfileStats stats;
+        Profiler_GetStats((ProfilePhase)phase, &stats);
+        fprintf(file, "%s,%llu,%.3f,%.3f,%.3f,%.3f\n",
+                phaseNames[phase], (unsigned long long)stats.samples,
+                stats.meanMicroseconds, stats.p50Microseconds,
+                stats.p99Microseconds, stats.maxMicroseconds);
+    }
+
+    bool isWritten = (ferror(file) == 0);
+    return (fclose(file) == 0) && isWritten;
+}
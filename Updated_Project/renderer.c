@@ -9,28 +9,72 @@
  */
 
 #include "snake_game.h"
+#include <assert.h>
+
+// ============================================================================
+// RENDERER STATE
+// ============================================================================
+
+/*
+ * Background and grid pre-rendered into a texture
+ * Rebuilt only when the window or board layout changes
+ */
+typedef struct {
+    RenderTexture2D texture;
+    bool isValid;
+    int width;
+    int height;
+    int columns;
+    int rows;
+    Position gridOffset;
+} GridCache;
+
+/*
+ * Persistent framebuffer holding the last drawn board
+ * Remembers which part of the snake ring and which food cell it shows,
+ * so the next update only touches cells that changed
+ */
+typedef struct {
+    RenderTexture2D texture;
+    bool isValid;
+    bool needsFullRedraw;
+    uint32_t headIndex;
+    uint32_t length;
+    uint32_t foodCell;
+    bool foodActive;
+} BoardCache;
+
+static GridCache gridCache = { 0 };
+static BoardCache boardCache = { 0 };
 
 // ============================================================================
 // GRID RENDERING
 // ============================================================================
 
 /*
- * Draw the game grid
+ * Draw the grid lines directly
  * Renders vertical and horizontal lines to create grid pattern
  * 
  * @param gridOffset - Offset for grid positioning
  */
-void Renderer_DrawGrid(Vector2 gridOffset)
+static void Renderer_DrawGridLines(Position gridOffset)
 {
     int cols = Utils_GetGridColumns();
     int rows = Utils_GetGridRows();
+    int cellSize = Utils_GetCellSize();
+
+    // Lines would cover tiny cells entirely
+    if (cellSize < GRID_LINES_MIN_CELL)
+    {
+        return;
+    }
 
     // Draw vertical lines
     for (int i = 0; i <= cols; i++)
     {
         DrawLineV(
-            (Vector2){ gridOffset.x + i * SQUARE_SIZE, gridOffset.y },
-            (Vector2){ gridOffset.x + i * SQUARE_SIZE, gridOffset.y + rows * SQUARE_SIZE },
+            (Vector2){ gridOffset.x + i * cellSize, gridOffset.y },
+            (Vector2){ gridOffset.x + i * cellSize, gridOffset.y + rows * cellSize },
             LIGHTGRAY
         );
     }
@@ -39,13 +83,561 @@ void Renderer_DrawGrid(Vector2 gridOffset)
     for (int i = 0; i <= rows; i++)
     {
         DrawLineV(
-            (Vector2){ gridOffset.x, gridOffset.y + i * SQUARE_SIZE },
-            (Vector2){ gridOffset.x + cols * SQUARE_SIZE, gridOffset.y + i * SQUARE_SIZE },
+            (Vector2){ gridOffset.x, gridOffset.y + i * cellSize },
+            (Vector2){ gridOffset.x + cols * cellSize, gridOffset.y + i * cellSize },
             LIGHTGRAY
         );
     }
 }
 
+/*
+ * Check whether the cached grid still matches the window and board
+ */
+static bool Renderer_IsGridCacheCurrent(Position gridOffset)
+{
+    return gridCache.isValid &&
+           (gridCache.width == GetScreenWidth()) &&
+           (gridCache.height == GetScreenHeight()) &&
+           (gridCache.columns == Utils_GetGridColumns()) &&
+           (gridCache.rows == Utils_GetGridRows()) &&
+           (gridCache.gridOffset.x == gridOffset.x) &&
+           (gridCache.gridOffset.y == gridOffset.y);
+}
+
+/*
+ * Build the cached background and grid texture if it is out of date
+ * Must be called with a window open and outside BeginDrawing
+ * 
+ * @param gridOffset - Offset for grid positioning
+ */
+void Renderer_Initialize(Position gridOffset)
+{
+    if (Renderer_IsGridCacheCurrent(gridOffset))
+    {
+        return;
+    }
+
+    Renderer_Cleanup();
+
+    gridCache.width = GetScreenWidth();
+    gridCache.height = GetScreenHeight();
+    gridCache.columns = Utils_GetGridColumns();
+    gridCache.rows = Utils_GetGridRows();
+    gridCache.gridOffset = gridOffset;
+    gridCache.texture = LoadRenderTexture(gridCache.width, gridCache.height);
+    gridCache.isValid = (gridCache.texture.id != 0);
+
+    if (gridCache.isValid)
+    {
+        BeginTextureMode(gridCache.texture);
+        ClearBackground(BLACK);
+        Renderer_DrawGridLines(gridOffset);
+        EndTextureMode();
+    }
+
+    boardCache.texture = LoadRenderTexture(gridCache.width, gridCache.height);
+    boardCache.isValid = gridCache.isValid && (boardCache.texture.id != 0);
+    boardCache.needsFullRedraw = true;
+}
+
+/*
+ * Release the cached grid and board textures
+ */
+void Renderer_Cleanup(void)
+{
+    if (gridCache.isValid)
+    {
+        UnloadRenderTexture(gridCache.texture);
+        gridCache.isValid = false;
+    }
+
+    if (boardCache.texture.id != 0)
+    {
+        UnloadRenderTexture(boardCache.texture);
+        boardCache.texture.id = 0;
+        boardCache.isValid = false;
+    }
+}
+
+/*
+ * Draw the background and game grid
+ * One textured quad from the cache; falls back to drawing the lines if
+ * the cache is stale (its rebuild is deferred to the next
+ * Renderer_Initialize, which cannot run inside BeginDrawing)
+ * 
+ * @param gridOffset - Offset for grid positioning
+ */
+void Renderer_DrawGrid(Position gridOffset)
+{
+    if (!Renderer_IsGridCacheCurrent(gridOffset))
+    {
+        Renderer_DrawGridLines(gridOffset);
+        return;
+    }
+
+    // Render textures are stored upside down, hence the negative height
+    DrawTextureRec(
+        gridCache.texture.texture,
+        (Rectangle){ 0, 0, (float)gridCache.width, -(float)gridCache.height },
+        (Vector2){ 0, 0 },
+        WHITE
+    );
+}
+
+// ============================================================================
+// ENTITY RENDERING
+// ============================================================================
+
+/*
+ * Draw the snake body (every segment except the head) in sky blue
+ * Straight runs are merged into one rectangle each, so the number of
+ * rectangles follows the number of turns rather than the length.
+ * 
+ * @param snake - Pointer to snake to render
+ * @param gridOffset - Offset for grid positioning
+ */
+void Snake_RenderBody(const Snake* snake, Position gridOffset)
+{
+    assert(snake != NULL);
+
+    int columns = Utils_GetGridColumns();
+    int cellSize = Utils_GetCellSize();
+    int length = (int)snake->length;
+    int segment = 1;
+
+    while (segment < length)
+    {
+        int cell = Snake_GetSegmentCell(snake, segment++);
+        int minColumn = cell % columns;
+        int minRow = cell / columns;
+        int maxColumn = minColumn;
+        int maxRow = minRow;
+        int lastColumn = minColumn;
+        int lastRow = minRow;
+        int stepX = 0;
+        int stepY = 0;
+
+        // Extend while each segment is one cell further in the same direction;
+        // a turn or a wrap across the edge starts a new run
+        while (segment < length)
+        {
+            int next = Snake_GetSegmentCell(snake, segment);
+            int column = next % columns;
+            int row = next / columns;
+            int dx = column - lastColumn;
+            int dy = row - lastRow;
+            bool isStep = (dx * dx + dy * dy) == 1;
+            bool isStraight = ((stepX == 0) && (stepY == 0)) || ((dx == stepX) && (dy == stepY));
+
+            if (!isStep || !isStraight)
+            {
+                break;
+            }
+
+            stepX = dx;
+            stepY = dy;
+            lastColumn = column;
+            lastRow = row;
+            if (column < minColumn) minColumn = column;
+            if (column > maxColumn) maxColumn = column;
+            if (row < minRow) minRow = row;
+            if (row > maxRow) maxRow = row;
+            segment++;
+        }
+
+        DrawRectangleRec(
+            (Rectangle){
+                gridOffset.x + (float)(minColumn * cellSize),
+                gridOffset.y + (float)(minRow * cellSize),
+                (float)((maxColumn - minColumn + 1) * cellSize),
+                (float)((maxRow - minRow + 1) * cellSize)
+            },
+            SKYBLUE
+        );
+    }
+}
+
+/*
+ * Draw one cell-sized square part way between two neighbouring cells
+ * Cells that are not neighbours (a wrap across the edge) snap to the target
+ */
+static void Renderer_DrawSlidingCell(int fromCell, int toCell, float alpha,
+                                     Position gridOffset, Color color)
+{
+    Position to = Utils_GetCellPosition(toCell, gridOffset);
+    Position from = Utils_GetCellPosition(fromCell, gridOffset);
+    float cellSize = (float)Utils_GetCellSize();
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+
+    if ((alpha >= 1.0f) || (dx * dx + dy * dy != cellSize * cellSize))
+    {
+        from = to;
+    }
+
+    DrawRectangleV(
+        (Vector2){ from.x + (to.x - from.x) * alpha, from.y + (to.y - from.y) * alpha },
+        (Vector2){ cellSize, cellSize },
+        color
+    );
+}
+
+/*
+ * Draw the moving ends of the snake part way through a tick
+ * The head slides from its previous cell into the current one and the
+ * tail slides off the cell it just vacated
+ * 
+ * @param snake - Pointer to snake to render
+ * @param gridOffset - Offset for grid positioning
+ * @param alpha - Progress from the previous move to the next, 0 to 1
+ *                (1 draws the snake exactly on its cells)
+ * @param tailMoved - false if the last move grew the snake, so the tail
+ *                    did not move
+ */
+void Snake_RenderMotion(const Snake* snake, Position gridOffset, float alpha, bool tailMoved)
+{
+    assert(snake != NULL);
+
+    if ((alpha < 1.0f) && tailMoved && (snake->length > 1))
+    {
+        Renderer_DrawSlidingCell(
+            Snake_GetSegmentCell(snake, (int)snake->length),
+            Snake_GetSegmentCell(snake, (int)snake->length - 1),
+            alpha, gridOffset, SKYBLUE
+        );
+    }
+
+    // Head last so it stays on top; a lone head's previous cell is the
+    // ring slot just behind it
+    int previousHead = (alpha < 1.0f) ? Snake_GetSegmentCell(snake, 1) : Snake_GetSegmentCell(snake, 0);
+    Renderer_DrawSlidingCell(previousHead, Snake_GetSegmentCell(snake, 0), alpha, gridOffset, BLUE);
+}
+
+/*
+ * Draw snake to screen
+ * Head is blue, body segments are sky blue
+ * 
+ * @param snake - Pointer to snake to render
+ * @param gridOffset - Offset for grid positioning
+ * @param alpha - Progress through the current tick (see Snake_RenderMotion)
+ * @param tailMoved - false if the last move grew the snake
+ */
+void Snake_Render(const Snake* snake, Position gridOffset, float alpha, bool tailMoved)
+{
+    Snake_RenderBody(snake, gridOffset);
+    Snake_RenderMotion(snake, gridOffset, alpha, tailMoved);
+}
+
+/*
+ * Draw food to screen
+ * 
+ * @param food - Pointer to food to render
+ * @param gridOffset - Offset for grid positioning
+ */
+void Food_Render(const Food* food, Position gridOffset)
+{
+    assert(food != NULL);
+    
+    if (food->active)
+    {
+        Position position = Utils_GetCellPosition(food->cell, gridOffset);
+
+        DrawRectangleV(
+            (Vector2){ position.x, position.y },
+            (Vector2){ (float)Utils_GetCellSize(), (float)Utils_GetCellSize() },
+            YELLOW
+        );
+    }
+}
+
+// ============================================================================
+// INCREMENTAL BOARD RENDERING
+// ============================================================================
+
+/*
+ * Fill one cell with a solid color
+ */
+static void Renderer_FillCell(int cell, Position gridOffset, Color color)
+{
+    Position position = Utils_GetCellPosition(cell, gridOffset);
+
+    DrawRectangleV(
+        (Vector2){ position.x, position.y },
+        (Vector2){ (float)Utils_GetCellSize(), (float)Utils_GetCellSize() },
+        color
+    );
+}
+
+/*
+ * Restore one cell to background and grid by copying it from the grid cache
+ */
+static void Renderer_EraseCell(int cell, Position gridOffset)
+{
+    Position position = Utils_GetCellPosition(cell, gridOffset);
+    float cellSize = (float)Utils_GetCellSize();
+
+    // Render textures are stored upside down, so the source rect is flipped
+    DrawTextureRec(
+        gridCache.texture.texture,
+        (Rectangle){
+            position.x,
+            (float)gridCache.height - position.y - cellSize,
+            cellSize,
+            -cellSize
+        },
+        (Vector2){ position.x, position.y },
+        WHITE
+    );
+}
+
+/*
+ * Force the next Renderer_UpdateBoard to redraw the whole board
+ * Call whenever the snake is replaced rather than moved (restart, restore)
+ */
+void Renderer_InvalidateBoard(void)
+{
+    boardCache.needsFullRedraw = true;
+}
+
+/*
+ * Bring the persistent board texture up to date
+ * The texture holds the grid, the food and the body without the head.
+ * Only cells that changed since the last update are redrawn: the vacated
+ * tail cells, the new body cells (including the old head) and the food. Frames with no
+ * move do no drawing at all. Falls back to a full redraw when the ring has
+ * moved too far to tell what changed.
+ * Must be called outside BeginDrawing.
+ * 
+ * @param snake - Snake to show
+ * @param food - Food to show
+ * @param gridOffset - Offset for grid positioning
+ */
+void Renderer_UpdateBoard(const Snake* snake, const Food* food, Position gridOffset)
+{
+    assert(snake != NULL);
+    assert(food != NULL);
+
+    if (!boardCache.isValid)
+    {
+        return;
+    }
+
+    int capacity = (int)snake->capacity;
+    int advance = ((int)snake->headIndex - (int)boardCache.headIndex + capacity) % capacity;
+    int growth = (int)snake->length - (int)boardCache.length;
+    int vacated = advance - growth;
+    bool foodChanged = (food->active != boardCache.foodActive) || (food->cell != boardCache.foodCell);
+
+    if (!boardCache.needsFullRedraw && (advance == 0) && (growth == 0) && !foodChanged)
+    {
+        return;
+    }
+
+    // The old slots must not have been overwritten by the new head slots
+    bool canPatch = !boardCache.needsFullRedraw &&
+                    (growth >= 0) && (vacated >= 0) && (vacated <= (int)boardCache.length) &&
+                    (advance + (int)boardCache.length < capacity);
+
+    BeginTextureMode(boardCache.texture);
+
+    if (canPatch)
+    {
+        int oldTailSlot = (int)boardCache.headIndex - (int)boardCache.length + 1;
+
+        for (int i = 0; i < vacated; i++)
+        {
+            int slot = (oldTailSlot + i + capacity) % capacity;
+            Renderer_EraseCell(snake->body[slot], gridOffset);
+        }
+
+        if (foodChanged && boardCache.foodActive)
+        {
+            Renderer_EraseCell(boardCache.foodCell, gridOffset);
+        }
+
+        if (foodChanged && food->active)
+        {
+            Renderer_FillCell(food->cell, gridOffset, YELLOW);
+        }
+
+        // New body cells, including the old head; the head itself moves
+        // every frame and is drawn on top by Snake_RenderMotion
+        int lastNew = (advance < (int)snake->length - 1) ? advance : (int)snake->length - 1;
+        for (int i = lastNew; i >= 1; i--)
+        {
+            Renderer_FillCell(Snake_GetSegmentCell(snake, i), gridOffset, SKYBLUE);
+        }
+    }
+    else
+    {
+        Renderer_DrawGrid(gridOffset);
+        Snake_RenderBody(snake, gridOffset);
+        Food_Render(food, gridOffset);
+    }
+
+    EndTextureMode();
+
+    boardCache.needsFullRedraw = false;
+    boardCache.headIndex = snake->headIndex;
+    boardCache.length = snake->length;
+    boardCache.foodCell = food->cell;
+    boardCache.foodActive = food->active;
+}
+
+/*
+ * Draw the board without the moving snake ends: one blit of the persistent
+ * texture, or everything directly if the texture is unavailable
+ * 
+ * @param snake - Snake to show
+ * @param food - Food to show
+ * @param gridOffset - Offset for grid positioning
+ */
+void Renderer_DrawBoard(const Snake* snake, const Food* food, Position gridOffset)
+{
+    if (!boardCache.isValid || boardCache.needsFullRedraw)
+    {
+        Renderer_DrawGrid(gridOffset);
+        Snake_RenderBody(snake, gridOffset);
+        Food_Render(food, gridOffset);
+        return;
+    }
+
+    DrawTextureRec(
+        boardCache.texture.texture,
+        (Rectangle){ 0, 0, (float)gridCache.width, -(float)gridCache.height },
+        (Vector2){ 0, 0 },
+        WHITE
+    );
+}
+
+/*
+ * Mark a shortest way from the head to the food with a dot per cell
+ * The way is read off the distance field one step at a time, so the
+ * cost follows the path length
+ * 
+ * @param field - Distance field brought up to date with the game
+ * @param snake - Snake whose head the way starts at
+ * @param gridOffset - Offset for grid positioning
+ */
+void Renderer_DrawPathHint(const PathField* field, const Snake* snake, Position gridOffset)
+{
+    assert(field != NULL);
+    assert(snake != NULL);
+
+    float cellSize = (float)Utils_GetCellSize();
+    float dotSize = cellSize / 3.0f;
+    int cell = Path_GetStep(field, (int)snake->body[snake->headIndex]);
+
+    // Every step is one move closer, so the walk ends at the food
+    while ((cell >= 0) && (Path_DistanceToFood(field, cell) > 0))
+    {
+        Position position = Utils_GetCellPosition(cell, gridOffset);
+        DrawRectangleV(
+            (Vector2){ position.x + dotSize, position.y + dotSize },
+            (Vector2){ dotSize, dotSize },
+            Fade(GREEN, 0.6f)
+        );
+        cell = Path_GetStep(field, cell);
+    }
+}
+
+// ============================================================================
+// MATCH RENDERING
+// ============================================================================
+
+// Bot colors, picked by snake index; players use the single-game blues
+static const Color matchBotColors[] = {
+    { 230, 41, 55, 255 },   // red
+    { 255, 161, 0, 255 },   // orange
+    { 200, 122, 255, 255 }, // purple
+    { 255, 109, 194, 255 }, // pink
+    { 0, 228, 48, 255 },    // green
+    { 127, 106, 79, 255 },  // brown
+    { 0, 158, 47, 255 },    // lime
+    { 190, 33, 55, 255 }    // maroon
+};
+
+/*
+ * Body color of a match snake
+ */
+static Color Renderer_GetMatchColor(int index, int playerCount)
+{
+    if (index < playerCount)
+    {
+        return (index == 0) ? SKYBLUE : WHITE;
+    }
+
+    int colorCount = (int)(sizeof(matchBotColors) / sizeof(matchBotColors[0]));
+    return matchBotColors[(index - playerCount) % colorCount];
+}
+
+/*
+ * Draw every food item and every live snake of a match
+ * Each body is walked from tail to head through the ownership links, so
+ * the cost follows the total snake length; heads are drawn darker
+ * 
+ * @param match - Match to draw
+ * @param gridOffset - Offset for grid positioning
+ * @param playerCount - Leading snakes that are local players
+ */
+void Renderer_DrawMatch(const MatchState* match, Position gridOffset, int playerCount)
+{
+    assert(match != NULL);
+
+    for (int i = 0; i < match->foodCount; i++)
+    {
+        Food_Render(&match->foods[i], gridOffset);
+    }
+
+    for (int i = 0; i < match->snakeCount; i++)
+    {
+        const MatchSnake* snake = &match->snakes[i];
+        if (!snake->isAlive)
+        {
+            continue;
+        }
+
+        Color color = Renderer_GetMatchColor(i, playerCount);
+        uint32_t cell = snake->tailCell;
+        for (uint32_t segment = 1; segment < snake->length; segment++)
+        {
+            Renderer_FillCell((int)cell, gridOffset, color);
+            cell = match->nextCell[cell];
+        }
+
+        Color headColor = { (unsigned char)(color.r / 2), (unsigned char)(color.g / 2),
+                            (unsigned char)(color.b / 2), 255 };
+        Renderer_FillCell((int)snake->headCell, gridOffset, (i < playerCount) ? BLUE : headColor);
+    }
+}
+
+/*
+ * Draw the match scoreboard: each player's score (or respawn wait) and
+ * how many snakes are alive
+ * 
+ * @param match - Match to describe
+ * @param playerCount - Leading snakes that are local players
+ */
+void Renderer_DrawMatchScores(const MatchState* match, int playerCount)
+{
+    assert(match != NULL);
+
+    int y = 10;
+
+    for (int i = 0; i < playerCount; i++)
+    {
+        const MatchSnake* snake = &match->snakes[i];
+        const char* text = snake->isAlive
+            ? TextFormat("P%d: %d", i + 1, snake->score)
+            : TextFormat("P%d: %d (respawn in %d)", i + 1, snake->score, snake->respawnCountdown);
+
+        DrawText(text, 10, y, 20, Renderer_GetMatchColor(i, playerCount));
+        y += 24;
+    }
+
+    DrawText(TextFormat("ALIVE: %d / %d", match->aliveCount, match->snakeCount), 10, y, 20, LIGHTGRAY);
+}
+
 // ============================================================================
 // UI OVERLAY RENDERING
 // ============================================================================
@@ -84,6 +676,70 @@ void Renderer_DrawFreezeEffect(void)
     );
 }
 
+/*
+ * Draw frame timing in the top-left corner
+ * 
+ * @param frameMilliseconds - Time between the last two frames
+ * @param drawMilliseconds - CPU time spent submitting the board
+ */
+void Renderer_DrawFrameTime(float frameMilliseconds, double drawMilliseconds)
+{
+    DrawText(
+        TextFormat("frame %.2f ms  draw %.3f ms", frameMilliseconds, drawMilliseconds),
+        4,
+        4,
+        10,
+        GREEN
+    );
+}
+
+/*
+ * Draw input latency below the frame timing
+ * 
+ * @param lastMilliseconds - Latency of the most recent turn
+ * @param averageMilliseconds - Smoothed latency
+ * @param maxMilliseconds - Worst latency this round
+ */
+void Renderer_DrawInputLatency(double lastMilliseconds, double averageMilliseconds, double maxMilliseconds)
+{
+    DrawText(
+        TextFormat("input %.1f ms  avg %.1f ms  max %.1f ms",
+                   lastMilliseconds, averageMilliseconds, maxMilliseconds),
+        4,
+        16,
+        10,
+        GREEN
+    );
+}
+
+/*
+ * Draw the profiler table in the top-right corner
+ * One row per phase: per-frame p50, p99 and max in microseconds
+ */
+void Renderer_DrawProfiler(void)
+{
+    const int lineHeight = 12;
+    const int panelWidth = 250;
+    int x = SCREEN_WIDTH - panelWidth - 4;
+    int y = 4;
+
+    DrawRectangle(x - 4, y - 2, panelWidth + 4, (PROFILE_PHASE_COUNT + 1) * lineHeight + 4,
+                  Fade(BLACK, 0.7f));
+    DrawText("phase            p50 us    p99 us    max us", x, y, 10, GREEN);
+
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        ProfileStats stats;
+        Profiler_GetStats((ProfilePhase)phase, &stats);
+
+        y += lineHeight;
+        DrawText(Profiler_GetPhaseName((ProfilePhase)phase), x, y, 10, GREEN);
+        DrawText(TextFormat("%8.1f  %8.1f  %8.1f", stats.p50Microseconds,
+                            stats.p99Microseconds, stats.maxMicroseconds),
+                 x + 100, y, 10, GREEN);
+    }
+}
+
 /*
  * Draw game over screen
  * Shows final score and restart instructions
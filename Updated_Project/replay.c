@@ -0,0 +1,519 @@
+/*
+ * replay.c
+ *
+ * Replay recording and playback module
+ * A game is fully determined by its seed and the turns applied to it, so
+ * a replay stores only those. Every turn is perpendicular to the current
+ * heading, which leaves one bit (clockwise or not) plus the number of
+ * ticks since the previous turn, written as a varint.
+ *
+ * Turn stream: varint((tickDelta << 1) | clockwise) with tickDelta >= 1,
+ * terminated by a zero followed by varint(ticks from the last turn to the
+ * end of the game).
+ * File: "SNKR", version byte, varint seed, varint columns, varint rows,
+ * turn stream. Version 1 files have no board size and use the default board.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_MAGIC        "SNKR"
+#define REPLAY_MAGIC_SIZE   4
+#define REPLAY_VERSION      2
+#define REPLAY_VERSION_V1   1   // Default board only, no size in the header
+#define REPLAY_MAX_FILE     (64 * 1024 * 1024)
+#define VARINT_MAX_BYTES    10
+
+// ============================================================================
+// VARINT ENCODING
+// ============================================================================
+
+/*
+ * Make room for at least extra more bytes in the turn stream
+ *
+ * @param replay - Pointer to replay
+ * @param extra - Bytes about to be appended
+ * @return true on success, false if memory could not be allocated
+ */
+static bool Replay_Reserve(Replay* replay, size_t extra)
+{
+    if (replay->size + extra <= replay->capacity)
+    {
+        return true;
+    }
+
+    size_t capacity = (replay->capacity > 0) ? replay->capacity * 2 : 256;
+    while (capacity < replay->size + extra)
+    {
+        capacity *= 2;
+    }
+
+    uint8_t* data = (replay->arena != NULL)
+                    ? Arena_Resize(replay->arena, replay->data, replay->capacity, capacity, 1)
+                    : realloc(replay->data, capacity);
+    if (data == NULL)
+    {
+        return false;
+    }
+
+    replay->data = data;
+    replay->capacity = capacity;
+    return true;
+}
+
+/*
+ * Encode an unsigned value as a little-endian base-128 varint
+ *
+ * @param out - Buffer with room for VARINT_MAX_BYTES bytes
+ * @param value - Value to encode
+ * @return Number of bytes written
+ */
+static size_t Replay_EncodeVarint(uint8_t* out, uint64_t value)
+{
+    size_t size = 0;
+
+    while (value >= 0x80)
+    {
+        out[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = (uint8_t)value;
+
+    return size;
+}
+
+/*
+ * Append a varint to the turn stream
+ *
+ * @param replay - Pointer to replay
+ * @param value - Value to append
+ * @return true on success, false if memory could not be allocated
+ */
+static bool Replay_WriteVarint(Replay* replay, uint64_t value)
+{
+    if (!Replay_Reserve(replay, VARINT_MAX_BYTES))
+    {
+        return false;
+    }
+
+    replay->size += Replay_EncodeVarint(replay->data + replay->size, value);
+    return true;
+}
+
+/*
+ * Read a varint from a byte buffer
+ *
+ * @param data - Buffer to read from
+ * @param size - Buffer size in bytes
+ * @param offset - Read position, advanced past the varint
+ * @param value - Receives the decoded value
+ * @return true on success, false if the buffer ends mid-varint
+ */
+static bool Replay_ReadVarint(const uint8_t* data, size_t size, size_t* offset, uint64_t* value)
+{
+    uint64_t result = 0;
+
+    for (int shift = 0; shift < 7 * VARINT_MAX_BYTES; shift += 7)
+    {
+        if (*offset >= size)
+        {
+            return false;
+        }
+
+        uint8_t byte = data[(*offset)++];
+        result |= (uint64_t)(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// ============================================================================
+// TURN ENCODING
+// ============================================================================
+
+/*
+ * Get the direction an action asks for
+ */
+static void Replay_GetActionDirection(SimAction action, int* directionX, int* directionY)
+{
+    *directionX = (action == SIM_ACTION_RIGHT) - (action == SIM_ACTION_LEFT);
+    *directionY = (action == SIM_ACTION_DOWN) - (action == SIM_ACTION_UP);
+}
+
+/*
+ * Get the action that heads in a direction
+ */
+static SimAction Replay_GetDirectionAction(int directionX, int directionY)
+{
+    if (directionX > 0) return SIM_ACTION_RIGHT;
+    if (directionX < 0) return SIM_ACTION_LEFT;
+    if (directionY > 0) return SIM_ACTION_DOWN;
+    return SIM_ACTION_UP;
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+/*
+ * Initialize an empty replay that owns no memory yet
+ * With an arena the turn stream grows in place at the top of the arena;
+ * resetting the arena past it requires initializing the replay again
+ *
+ * @param replay - Pointer to replay to initialize
+ * @param arena - Arena for the turn stream, or NULL for the heap
+ */
+void Replay_Initialize(Replay* replay, Arena* arena)
+{
+    assert(replay != NULL);
+
+    memset(replay, 0, sizeof(Replay));
+    replay->arena = arena;
+    replay->lastTick = -1;
+}
+
+/*
+ * Release the memory owned by a replay
+ * Arena memory is left to the arena
+ *
+ * @param replay - Pointer to replay to destroy
+ */
+void Replay_Destroy(Replay* replay)
+{
+    assert(replay != NULL);
+
+    if (replay->arena == NULL)
+    {
+        free(replay->data);
+    }
+    Replay_Initialize(replay, replay->arena);
+}
+
+/*
+ * Start recording a new game, keeping the buffer for reuse
+ *
+ * The board size in use is recorded with the seed
+ *
+ * @param replay - Pointer to replay
+ * @param seed - Seed the game was initialized with
+ */
+void Replay_Begin(Replay* replay, uint64_t seed)
+{
+    assert(replay != NULL);
+
+    replay->seed = seed;
+    replay->columns = Utils_GetGridColumns();
+    replay->rows = Utils_GetGridRows();
+    replay->size = 0;
+    replay->lastTick = -1;
+    replay->tickCount = 0;
+    replay->isFinished = false;
+}
+
+/*
+ * Record the action about to be passed to Sim_Step
+ * Actions the snake would ignore are not stored, so only real direction
+ * changes take space
+ *
+ * @param replay - Pointer to replay
+ * @param tick - Simulation tick count before the step
+ * @param snake - Snake the action will be applied to
+ * @param action - Action for this tick
+ * @return true on success, false if memory could not be allocated
+ */
+bool Replay_RecordAction(Replay* replay, int tick, const Snake* snake, SimAction action)
+{
+    assert(replay != NULL);
+    assert(snake != NULL);
+    assert(!replay->isFinished);
+    assert(tick > replay->lastTick);
+
+    if (!Snake_CanApplyAction(snake, action))
+    {
+        return true;
+    }
+
+    int directionX;
+    int directionY;
+    Replay_GetActionDirection(action, &directionX, &directionY);
+    bool clockwise = (directionX == -snake->directionY) && (directionY == snake->directionX);
+
+    uint64_t delta = (uint64_t)(tick - replay->lastTick);
+    if (!Replay_WriteVarint(replay, (delta << 1) | clockwise))
+    {
+        return false;
+    }
+
+    replay->lastTick = tick;
+    return true;
+}
+
+/*
+ * Close the turn stream at the end of a game
+ *
+ * @param replay - Pointer to replay
+ * @param tickCount - Total number of ticks the game ran for
+ * @return true on success, false if memory could not be allocated
+ */
+bool Replay_Finish(Replay* replay, int tickCount)
+{
+    assert(replay != NULL);
+    assert(tickCount > replay->lastTick);
+
+    if (replay->isFinished)
+    {
+        return true;
+    }
+
+    // Reserve both varints up front so a failure leaves the stream open
+    if (!Replay_Reserve(replay, 2 * VARINT_MAX_BYTES))
+    {
+        return false;
+    }
+
+    Replay_WriteVarint(replay, 0);
+    Replay_WriteVarint(replay, (uint64_t)(tickCount - (replay->lastTick + 1)));
+
+    replay->tickCount = tickCount;
+    replay->isFinished = true;
+    return true;
+}
+
+// ============================================================================
+// FILE INPUT AND OUTPUT
+// ============================================================================
+
+/*
+ * Write a finished replay to a file
+ *
+ * @param replay - Pointer to finished replay
+ * @param path - File to create or overwrite
+ * @return true on success, false on I/O failure
+ */
+bool Replay_Save(const Replay* replay, const char* path)
+{
+    assert(replay != NULL);
+    assert(path != NULL);
+    assert(replay->isFinished);
+
+    uint8_t header[REPLAY_MAGIC_SIZE + 1 + 3 * VARINT_MAX_BYTES];
+    size_t headerSize = 0;
+
+    memcpy(header, REPLAY_MAGIC, REPLAY_MAGIC_SIZE);
+    headerSize += REPLAY_MAGIC_SIZE;
+    header[headerSize++] = REPLAY_VERSION;
+    headerSize += Replay_EncodeVarint(header + headerSize, replay->seed);
+    headerSize += Replay_EncodeVarint(header + headerSize, (uint64_t)replay->columns);
+    headerSize += Replay_EncodeVarint(header + headerSize, (uint64_t)replay->rows);
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool ok = (fwrite(header, 1, headerSize, file) == headerSize) &&
+              (fwrite(replay->data, 1, replay->size, file) == replay->size);
+
+    return (fclose(file) == 0) && ok;
+}
+
+/*
+ * Read and validate a replay file
+ * On failure the replay is left empty
+ *
+ * @param replay - Pointer to initialized replay to fill
+ * @param path - File to read
+ * @return true on success, false on I/O failure or malformed data
+ */
+bool Replay_Load(Replay* replay, const char* path)
+{
+    assert(replay != NULL);
+    assert(path != NULL);
+
+    Replay_Begin(replay, 0);
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    uint8_t header[REPLAY_MAGIC_SIZE + 1];
+    bool ok = (fread(header, 1, sizeof(header), file) == sizeof(header)) &&
+              (memcmp(header, REPLAY_MAGIC, REPLAY_MAGIC_SIZE) == 0) &&
+              ((header[REPLAY_MAGIC_SIZE] == REPLAY_VERSION) ||
+               (header[REPLAY_MAGIC_SIZE] == REPLAY_VERSION_V1));
+    bool hasBoardSize = ok && (header[REPLAY_MAGIC_SIZE] == REPLAY_VERSION);
+
+    // Read the rest (seed, board size and turn stream) in one go
+    while (ok && !feof(file))
+    {
+        ok = (replay->size < REPLAY_MAX_FILE) && Replay_Reserve(replay, 4096);
+        if (ok)
+        {
+            replay->size += fread(replay->data + replay->size, 1,
+                                  replay->capacity - replay->size, file);
+            ok = !ferror(file);
+        }
+    }
+    fclose(file);
+
+    // Split off the seed and board size, then walk the turns to find the
+    // end of the game
+    size_t offset = 0;
+    uint64_t value = 0;
+    uint64_t columns = DEFAULT_GRID_COLUMNS;
+    uint64_t rows = DEFAULT_GRID_ROWS;
+    ok = ok && Replay_ReadVarint(replay->data, replay->size, &offset, &replay->seed);
+    if (hasBoardSize)
+    {
+        ok = ok && Replay_ReadVarint(replay->data, replay->size, &offset, &columns) &&
+             Replay_ReadVarint(replay->data, replay->size, &offset, &rows) &&
+             (columns >= BOARD_MIN_SIZE) && (columns <= BOARD_MAX_SIZE) &&
+             (rows >= BOARD_MIN_SIZE) && (rows <= BOARD_MAX_SIZE);
+    }
+    size_t headerSize = offset;
+
+    int tick = -1;
+    while (ok && Replay_ReadVarint(replay->data, replay->size, &offset, &value) && (value != 0))
+    {
+        ok = ((value >> 1) >= 1) && ((value >> 1) <= (uint64_t)(INT32_MAX - 1 - tick));
+        tick += (int)(value >> 1);
+    }
+
+    ok = ok && (value == 0) &&
+         Replay_ReadVarint(replay->data, replay->size, &offset, &value) &&
+         (offset == replay->size) &&
+         (value <= (uint64_t)(INT32_MAX - 1 - tick));
+
+    if (!ok)
+    {
+        Replay_Begin(replay, 0);
+        return false;
+    }
+
+    // Drop the header varints so the buffer holds only the turn stream
+    memmove(replay->data, replay->data + headerSize, replay->size - headerSize);
+    replay->size -= headerSize;
+    replay->columns = (int)columns;
+    replay->rows = (int)rows;
+
+    replay->lastTick = tick;
+    replay->tickCount = tick + 1 + (int)value;
+    replay->isFinished = true;
+    return true;
+}
+
+// ============================================================================
+// PLAYBACK
+// ============================================================================
+
+/*
+ * Read the next turn into the cursor, or mark the turns exhausted
+ */
+static void Replay_AdvanceCursor(ReplayCursor* cursor)
+{
+    uint64_t value = 0;
+    const Replay* replay = cursor->replay;
+
+    if (!Replay_ReadVarint(replay->data, replay->size, &cursor->offset, &value) || (value == 0))
+    {
+        cursor->nextTick = -1;
+        return;
+    }
+
+    cursor->nextTick += (int)(value >> 1);
+    cursor->clockwise = (value & 1) != 0;
+}
+
+/*
+ * Start playing a finished replay from its first tick
+ *
+ * @param cursor - Pointer to cursor to set up
+ * @param replay - Finished replay to play (must outlive the cursor)
+ */
+void Replay_BeginPlayback(ReplayCursor* cursor, const Replay* replay)
+{
+    assert(cursor != NULL);
+    assert(replay != NULL);
+    assert(replay->isFinished);
+
+    cursor->replay = replay;
+    cursor->offset = 0;
+    cursor->nextTick = -1;
+    cursor->clockwise = false;
+
+    Replay_AdvanceCursor(cursor);
+}
+
+/*
+ * Get the recorded action for a tick
+ * Must be called for every tick in order, before the Sim_Step for it
+ *
+ * @param cursor - Pointer to playback cursor
+ * @param tick - Simulation tick count before the step
+ * @param snake - Snake the action will be applied to
+ * @return Action to pass to Sim_Step
+ */
+SimAction Replay_NextAction(ReplayCursor* cursor, int tick, const Snake* snake)
+{
+    assert(cursor != NULL);
+    assert(snake != NULL);
+
+    if (tick != cursor->nextTick)
+    {
+        return SIM_ACTION_NONE;
+    }
+
+    int directionX = cursor->clockwise ? -snake->directionY : snake->directionY;
+    int directionY = cursor->clockwise ? snake->directionX : -snake->directionX;
+
+    Replay_AdvanceCursor(cursor);
+    return Replay_GetDirectionAction(directionX, directionY);
+}
+
+/*
+ * Re-simulate a whole replay headlessly
+ * Stops at the recorded end of the game or when the snake dies. The
+ * replay's board size must be the current one (Utils_SetBoardSize) and
+ * sim must have been created for it.
+ *
+ * @param replay - Finished replay to run
+ * @param sim - Receives the final simulation state
+ * @return true if the game ended exactly as recorded (same tick count)
+ */
+bool Replay_Simulate(const Replay* replay, SimState* sim)
+{
+    assert(replay != NULL);
+    assert(sim != NULL);
+
+    if ((replay->columns != Utils_GetGridColumns()) || (replay->rows != Utils_GetGridRows()))
+    {
+        return false;
+    }
+
+    ReplayCursor cursor;
+    Replay_BeginPlayback(&cursor, replay);
+    Sim_Initialize(sim, replay->seed);
+
+    while (!sim->isDead && (sim->tickCount < replay->tickCount))
+    {
+        SimAction action = Replay_NextAction(&cursor, sim->tickCount, &sim->snake);
+        Sim_Step(sim, action);
+    }
+
+    return (sim->tickCount == replay->tickCount) && (cursor.nextTick < 0);
+}
@@ -0,0 +1,97 @@
+/*
+ * rng.c
+ *
+ * Random number generator module
+ * Small PCG32 generator whose whole state is one 64-bit word, so every
+ * game can own its own stream: no shared state between threads and the
+ * same seed always reproduces the same game
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+
+#define RNG_MULTIPLIER  6364136223846793005ULL
+#define RNG_INCREMENT   1442695040888963407ULL
+
+// ============================================================================
+// SEEDING
+// ============================================================================
+
+/*
+ * Seed a generator
+ * The stream number is mixed into the seed (SplitMix64 finalizer) so that
+ * consecutive streams, e.g. one per game, start far apart
+ *
+ * @param rng - Pointer to generator to seed
+ * @param seed - Base seed
+ * @param stream - Stream number (such as a game index)
+ */
+void Rng_Seed(Rng* rng, uint64_t seed, uint64_t stream)
+{
+    assert(rng != NULL);
+
+    uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+
+    rng->state = 0;
+    Rng_Next(rng);
+    rng->state += z;
+    Rng_Next(rng);
+}
+
+// ============================================================================
+// NUMBER GENERATION
+// ============================================================================
+
+/*
+ * Produce the next 32 random bits
+ *
+ * @param rng - Pointer to generator
+ * @return Uniformly distributed 32-bit value
+ */
+uint32_t Rng_Next(Rng* rng)
+{
+    assert(rng != NULL);
+
+    uint64_t old = rng->state;
+    rng->state = old * RNG_MULTIPLIER + RNG_INCREMENT;
+
+    uint32_t xorShifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rotation = (uint32_t)(old >> 59);
+
+    return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+}
+
+/*
+ * Produce a uniformly distributed value below a bound
+ * Multiply-shift with rejection of the small biased zone (Lemire)
+ *
+ * @param rng - Pointer to generator
+ * @param bound - Exclusive upper limit (must be greater than zero)
+ * @return Value in the range [0, bound)
+ */
+uint32_t Rng_NextBounded(Rng* rng, uint32_t bound)
+{
+    assert(rng != NULL);
+    assert(bound > 0);
+
+    uint64_t product = (uint64_t)Rng_Next(rng) * bound;
+    uint32_t low = (uint32_t)product;
+
+    if (low < bound)
+    {
+        uint32_t threshold = (uint32_t)(-bound) % bound;
+        while (low < threshold)
+        {
+            product = (uint64_t)Rng_Next(rng) * bound;
+            low = (uint32_t)product;
+        }
+    }
+
+    return (uint32_t)(product >> 32);
+}
@@ -0,0 +1,585 @@
+/*
+ * sim.c
+ *
+ * Headless simulation core
+ * Advances one game by a single move tick without any window, input
+ * device or graphics context, so it can be driven by the interactive
+ * game loop, batch runners or servers alike
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <string.h>
+
+// ============================================================================
+// SIMULATION STORAGE
+// ============================================================================
+
+/*
+ * Number of 64-bit words in the occupancy bitset for a board
+ * Covers the ring capacity (one more than the cell count)
+ */
+static size_t Sim_GetOccupancyWords(int cellCount)
+{
+    return ((size_t)cellCount + 1 + 63) / 64;
+}
+
+/*
+ * Point the snake and free-cell arrays into the state's storage block
+ * Layout: occupancy bitset, snake ring, free list, free-list slots.
+ * The ring has one slot more than the board, so the slot the tail just
+ * left stays readable even when the snake covers every cell.
+ */
+static void Sim_BindStorage(SimState* sim)
+{
+    uint64_t* occupancy = (uint64_t*)sim->storage;
+    uint32_t* ring = (uint32_t*)(occupancy + Sim_GetOccupancyWords(sim->cellCount));
+
+    sim->snake.occupancy = occupancy;
+    sim->snake.body = ring;
+    sim->snake.capacity = (uint32_t)sim->cellCount + 1;
+    sim->freeCells.cells = ring + sim->cellCount + 1;
+    sim->freeCells.slotOf = sim->freeCells.cells + sim->cellCount;
+}
+
+/*
+ * Carve a simulation for the current board size out of an arena and
+ * start a game with seed 0. Memory grows with the board: 12 bytes and
+ * one bit per cell. It belongs to the arena and is released with it.
+ *
+ * @param sim - Pointer to simulation state to create
+ * @param arena - Arena to allocate from
+ * @return true on success, false if memory could not be allocated
+ */
+bool Sim_Create(SimState* sim, Arena* arena)
+{
+    assert(sim != NULL);
+    assert(arena != NULL);
+
+    memset(sim, 0, sizeof(SimState));
+
+    int cellCount = Utils_GetCellCount();
+    size_t storageSize = Sim_GetOccupancyWords(cellCount) * sizeof(uint64_t) +
+                         (3 * (size_t)cellCount + 1) * sizeof(uint32_t);
+
+    sim->storage = Arena_Allocate(arena, storageSize, sizeof(uint64_t));
+    if (sim->storage == NULL)
+    {
+        return false;
+    }
+
+    sim->cellCount = cellCount;
+    sim->storageSize = storageSize;
+    sim->isProfiled = true;
+    Sim_BindStorage(sim);
+    Sim_Initialize(sim, 0);
+
+    return true;
+}
+
+// ============================================================================
+// SIMULATION INITIALIZATION
+// ============================================================================
+
+/*
+ * Reset a simulation to the start of a new game
+ * The snake starts in the top-left cell heading right
+ *
+ * @param sim - Pointer to simulation state created for the current board
+ * @param seed - Seed for the game's random stream; equal seeds and
+ *               equal actions reproduce the same game
+ */
+void Sim_Initialize(SimState* sim, uint64_t seed)
+{
+    assert(sim != NULL);
+    assert(sim->storage != NULL);
+    assert(sim->cellCount == Utils_GetCellCount());
+
+    Rng_Seed(&sim->rng, seed, 0);
+    sim->seed = seed;
+    sim->score = 0;
+    sim->tickCount = 0;
+    sim->isDead = false;
+
+    Snake_Initialize(&sim->snake, 0);
+    FreeCells_Initialize(&sim->freeCells, sim->cellCount);
+    FreeCells_Remove(&sim->freeCells, 0);
+
+    Food_Initialize(&sim->food);
+    Food_Spawn(&sim->food, &sim->freeCells, &sim->rng);
+
+    Sim_AttachJournal(sim, sim->journal);
+}
+
+// ============================================================================
+// SIMULATION STEP
+// ============================================================================
+
+/*
+ * Changes recorded in SimUndo.flags
+ */
+enum {
+    SIM_UNDO_FOOD_ACTIVE = 1 << 0, // Food was on the board before the move
+    SIM_UNDO_TAIL_FREED  = 1 << 1, // The vacated tail was added to the free list
+    SIM_UNDO_HEAD_TAKEN  = 1 << 2, // The new head was removed from the free list
+    SIM_UNDO_ATE         = 1 << 3, // The snake grew and scored
+    SIM_UNDO_TAIL_TAKEN  = 1 << 4  // Growing took the tail back off the free list
+};
+
+/*
+ * Open the journal entry for the move about to be stepped
+ * Captures everything the move overwrites outright; the free-list slots
+ * are filled in by Sim_Step as it goes.
+ *
+ * @param sim - Simulation about to step
+ * @return Entry to fill in, or NULL when the step is not recorded
+ */
+static SimUndo* Sim_BeginUndo(SimState* sim)
+{
+    SimJournal* journal = sim->journal;
+    if (journal == NULL)
+    {
+        return NULL;
+    }
+
+    if (journal->count >= journal->capacity)
+    {
+        journal->isOverflowed = true;
+        return NULL;
+    }
+
+    const Snake* snake = &sim->snake;
+    uint32_t nextSlot = (snake->headIndex + 1 < snake->capacity) ? snake->headIndex + 1 : 0;
+    SimUndo* undo = &journal->moves[journal->count++];
+
+    undo->rngState = sim->rng.state;
+    undo->overwrittenCell = snake->body[nextSlot];
+    undo->foodCell = sim->food.cell;
+    undo->flags = sim->food.active ? SIM_UNDO_FOOD_ACTIVE : 0;
+    undo->directionX = snake->directionX;
+    undo->directionY = snake->directionY;
+
+    return undo;
+}
+
+/*
+ * Take back one recorded move, restoring the state bit for bit
+ * Undoes Sim_Step in reverse: growth, the free-list changes, then the
+ * occupancy and ring slot touched by Snake_UpdatePosition
+ *
+ * @param sim - Simulation the move was stepped on
+ * @param undo - Journal entry of that move
+ */
+static void Sim_UndoMove(SimState* sim, const SimUndo* undo)
+{
+    Snake* snake = &sim->snake;
+    FreeCellSet* freeCells = &sim->freeCells;
+    uint32_t headSlot = snake->headIndex;
+    uint32_t oldHeadSlot = (headSlot > 0) ? headSlot - 1 : snake->capacity - 1;
+    int headCell = (int)snake->body[headSlot];
+
+    if (undo->flags & SIM_UNDO_ATE)
+    {
+        if (undo->flags & SIM_UNDO_TAIL_TAKEN)
+        {
+            FreeCells_UndoRemove(freeCells, (int)undo->tailCell, (int)undo->tailSlot);
+        }
+        Occupancy_Release(snake->occupancy, (int)undo->tailCell);
+        snake->length--;
+        sim->score--;
+    }
+
+    if (undo->flags & SIM_UNDO_HEAD_TAKEN)
+    {
+        FreeCells_UndoRemove(freeCells, headCell, (int)undo->headSlot);
+    }
+    if (undo->flags & SIM_UNDO_TAIL_FREED)
+    {
+        FreeCells_UndoAdd(freeCells);
+    }
+
+    if (snake->length > 1)
+    {
+        Occupancy_Release(snake->occupancy, (int)snake->body[oldHeadSlot]);
+        Occupancy_Mark(snake->occupancy, (int)undo->tailCell);
+    }
+    snake->body[headSlot] = undo->overwrittenCell;
+    snake->headIndex = oldHeadSlot;
+    snake->directionX = undo->directionX;
+    snake->directionY = undo->directionY;
+
+    sim->rng.state = undo->rngState;
+    sim->food.cell = undo->foodCell;
+    sim->food.active = (undo->flags & SIM_UNDO_FOOD_ACTIVE) != 0;
+    sim->tickCount--;
+    sim->isDead = false;
+}
+
+/*
+ * Advance the simulation by one move tick
+ * Applies the action, moves the snake and resolves collisions and eating
+ *
+ * @param sim - Pointer to simulation state to advance
+ * @param action - Direction request for this tick
+ * @return Bit mask of SimEvent flags raised during the tick
+ */
+int Sim_Step(SimState* sim, SimAction action)
+{
+    assert(sim != NULL);
+
+    if (sim->isDead)
+    {
+        return SIM_EVENT_DIED;
+    }
+
+    int events = SIM_EVENT_NONE;
+    uint64_t phaseStart = sim->isProfiled ? Profiler_Begin() : 0;
+    SimUndo* undo = Sim_BeginUndo(sim);
+
+    Snake_ProcessInput(&sim->snake, action);
+
+    // Track the cells vacated and entered by this move in the free-cell index
+    FreeCellSet* freeCells = &sim->freeCells;
+    int tailCell = Snake_GetSegmentCell(&sim->snake, (int)sim->snake.length - 1);
+    Snake_UpdatePosition(&sim->snake);
+    int headCell = Snake_GetSegmentCell(&sim->snake, 0);
+
+    int freeCount = freeCells->count;
+    FreeCells_Add(freeCells, tailCell);
+    uint32_t headSlot = freeCells->slotOf[headCell];
+    int vacatedCount = freeCells->count;
+    FreeCells_Remove(freeCells, headCell);
+
+    // The set's size tells whether each call changed it
+    if (undo != NULL)
+    {
+        undo->tailCell = (uint32_t)tailCell;
+        undo->headSlot = headSlot;
+        undo->flags |= (vacatedCount != freeCount) ? SIM_UNDO_TAIL_FREED : 0;
+        undo->flags |= (freeCells->count != vacatedCount) ? SIM_UNDO_HEAD_TAKEN : 0;
+    }
+    sim->tickCount++;
+    phaseStart = Profiler_End(PROFILE_MOVEMENT, phaseStart);
+
+    if (Collision_CheckSnakeWithSelf(&sim->snake))
+    {
+        sim->isDead = true;
+        Profiler_End(PROFILE_COLLISION, phaseStart);
+        return events | SIM_EVENT_DIED;
+    }
+
+    if (Collision_CheckSnakeWithFood(&sim->snake, &sim->food))
+    {
+        uint32_t tailSlot = freeCells->slotOf[tailCell];
+        int grownCount = freeCells->count;
+
+        Snake_Grow(&sim->snake);
+        FreeCells_Remove(freeCells, tailCell);
+        if (undo != NULL)
+        {
+            undo->tailSlot = tailSlot;
+            undo->flags |= SIM_UNDO_ATE;
+            undo->flags |= (freeCells->count != grownCount) ? SIM_UNDO_TAIL_TAKEN : 0;
+        }
+        sim->food.active = false;
+        sim->score++;
+        events |= SIM_EVENT_ATE;
+    }
+    phaseStart = Profiler_End(PROFILE_COLLISION, phaseStart);
+
+    // Spawn food if not active
+    if (!sim->food.active)
+    {
+        Food_Spawn(&sim->food, freeCells, &sim->rng);
+        Profiler_End(PROFILE_FOOD_SPAWN, phaseStart);
+    }
+
+    return events;
+}
+
+// ============================================================================
+// COPY, SNAPSHOT AND RESTORE
+// ============================================================================
+
+/*
+ * Make one simulation an exact, independent copy of another
+ * Copies the whole storage block, so cost grows with the board; prefer
+ * snapshots for large boards and a journal for repeated rollback.
+ * The destination keeps its own journal, restarted at the copied state.
+ *
+ * @param destination - Simulation created for the same board size
+ * @param source - Simulation to copy
+ */
+void Sim_Copy(SimState* destination, const SimState* source)
+{
+    assert(destination != NULL);
+    assert(source != NULL);
+    assert(destination->cellCount == source->cellCount);
+
+    void* storage = destination->storage;
+    SimJournal* journal = destination->journal;
+
+    memcpy(storage, source->storage, source->storageSize);
+    *destination = *source;
+    destination->storage = storage;
+    Sim_BindStorage(destination);
+    Sim_AttachJournal(destination, journal);
+}
+
+/*
+ * Bytes per cell in snapshots of a board: 16-bit cells cover any board
+ * of up to 65535 cells
+ */
+static int Sim_GetSnapshotCellBytes(int cellCount)
+{
+    return (cellCount <= UINT16_MAX) ? (int)sizeof(uint16_t) : (int)sizeof(uint32_t);
+}
+
+/*
+ * Read one cell of a snapshot's cell buffer
+ */
+static uint32_t Sim_GetSnapshotCell(const SimSnapshot* snapshot, uint32_t index)
+{
+    if (snapshot->cellBytes == sizeof(uint16_t))
+    {
+        return ((const uint16_t*)snapshot->cells)[index];
+    }
+    return ((const uint32_t*)snapshot->cells)[index];
+}
+
+/*
+ * Take a snapshot buffer for boards of the given size from an arena
+ *
+ * @param snapshot - Pointer to snapshot to create
+ * @param cellCount - Cells on the board it will capture
+ * @param arena - Arena to allocate from
+ * @return true on success, false if memory could not be allocated
+ */
+bool Sim_CreateSnapshot(SimSnapshot* snapshot, int cellCount, Arena* arena)
+{
+    assert(snapshot != NULL);
+    assert(cellCount > 0);
+    assert(arena != NULL);
+
+    memset(snapshot, 0, sizeof(SimSnapshot));
+
+    int cellBytes = Sim_GetSnapshotCellBytes(cellCount);
+    snapshot->cells = Arena_Allocate(arena, (size_t)cellCount * (size_t)cellBytes, (size_t)cellBytes);
+    if (snapshot->cells == NULL)
+    {
+        return false;
+    }
+
+    snapshot->cellCount = cellCount;
+    snapshot->cellBytes = (uint8_t)cellBytes;
+    return true;
+}
+
+/*
+ * Total memory held by a snapshot: the header plus its cell buffer
+ *
+ * @param snapshot - Snapshot created by Sim_CreateSnapshot
+ * @return Size in bytes
+ */
+size_t Sim_GetSnapshotSize(const SimSnapshot* snapshot)
+{
+    assert(snapshot != NULL);
+
+    return sizeof(SimSnapshot) + (size_t)snapshot->cellCount * snapshot->cellBytes;
+}
+
+/*
+ * Capture a simulation in a snapshot
+ * Cost is one pass over the board; the ring slack and the lookup tables
+ * are left out and rebuilt on restore
+ *
+ * @param sim - Simulation state to capture
+ * @param snapshot - Snapshot created for the same board size
+ */
+void Sim_Snapshot(const SimState* sim, SimSnapshot* snapshot)
+{
+    assert(sim != NULL);
+    assert(snapshot != NULL);
+    assert(snapshot->cellCount == sim->cellCount);
+
+    const Snake* snake = &sim->snake;
+
+    snapshot->rngState = sim->rng.state;
+    snapshot->seed = sim->seed;
+    snapshot->score = sim->score;
+    snapshot->tickCount = sim->tickCount;
+    snapshot->length = snake->length;
+    snapshot->freeCount = (uint32_t)sim->freeCells.count;
+    snapshot->foodCell = sim->food.cell;
+    snapshot->foodActive = sim->food.active;
+    snapshot->isDead = sim->isDead;
+    snapshot->directionX = snake->directionX;
+    snapshot->directionY = snake->directionY;
+
+    if (snapshot->cellBytes == sizeof(uint16_t))
+    {
+        uint16_t* cells = snapshot->cells;
+
+        for (int i = 0; i < (int)snake->length; i++)
+        {
+            cells[i] = (uint16_t)Snake_GetSegmentCell(snake, i);
+        }
+
+        uint16_t* freeList = cells + snake->length;
+        for (int i = 0; i < sim->freeCells.count; i++)
+        {
+            freeList[i] = (uint16_t)sim->freeCells.cells[i];
+        }
+        return;
+    }
+
+    uint32_t* cells = snapshot->cells;
+
+    for (int i = 0; i < (int)snake->length; i++)
+    {
+        cells[i] = (uint32_t)Snake_GetSegmentCell(snake, i);
+    }
+
+    memcpy(cells + snake->length, sim->freeCells.cells,
+           (size_t)sim->freeCells.count * sizeof(uint32_t));
+}
+
+/*
+ * Rebuild a simulation from a snapshot
+ * The restored game continues exactly as the captured one would,
+ * including food placement
+ *
+ * @param sim - Simulation state created for the same board size
+ * @param snapshot - Snapshot taken by Sim_Snapshot
+ */
+void Sim_Restore(SimState* sim, const SimSnapshot* snapshot)
+{
+    assert(sim != NULL);
+    assert(snapshot != NULL);
+    assert(snapshot->cellCount == sim->cellCount);
+    assert(snapshot->length >= 1 && (int)snapshot->length <= sim->cellCount);
+
+    Snake* snake = &sim->snake;
+    FreeCellSet* freeCells = &sim->freeCells;
+
+    sim->rng.state = snapshot->rngState;
+    sim->seed = snapshot->seed;
+    sim->score = snapshot->score;
+    sim->tickCount = snapshot->tickCount;
+    sim->food.cell = snapshot->foodCell;
+    sim->food.active = snapshot->foodActive;
+    sim->isDead = snapshot->isDead;
+
+    // Lay the body out from slot 0 so segment i sits at slot length - 1 - i
+    snake->length = snapshot->length;
+    snake->headIndex = snapshot->length - 1;
+    snake->directionX = snapshot->directionX;
+    snake->directionY = snapshot->directionY;
+
+    Occupancy_ClearAll(snake->occupancy, (int)snake->capacity);
+    snake->body[snake->headIndex] = Sim_GetSnapshotCell(snapshot, 0);
+    for (uint32_t i = 1; i < snapshot->length; i++)
+    {
+        uint32_t cell = Sim_GetSnapshotCell(snapshot, i);
+
+        snake->body[snake->headIndex - i] = cell;
+        Occupancy_Mark(snake->occupancy, (int)cell);
+    }
+
+    // Free list keeps its order so later spawns draw the same cells
+    freeCells->count = (int)snapshot->freeCount;
+    for (uint32_t i = 0; i < snapshot->freeCount; i++)
+    {
+        uint32_t cell = Sim_GetSnapshotCell(snapshot, snapshot->length + i);
+
+        freeCells->cells[i] = cell;
+        freeCells->slotOf[cell] = i;
+    }
+
+    Sim_AttachJournal(sim, sim->journal);
+}
+
+// ============================================================================
+// MOVE JOURNAL
+// ============================================================================
+
+/*
+ * Take a journal buffer for up to capacity moves from an arena
+ * Each move costs sizeof(SimUndo) bytes, independent of the board size
+ *
+ * @param journal - Pointer to journal to create
+ * @param capacity - Most moves it can hold before overflowing
+ * @param arena - Arena to allocate from
+ * @return true on success, false if memory could not be allocated
+ */
+bool Sim_CreateJournal(SimJournal* journal, int capacity, Arena* arena)
+{
+    assert(journal != NULL);
+    assert(capacity > 0);
+    assert(arena != NULL);
+
+    memset(journal, 0, sizeof(SimJournal));
+    journal->moves = Arena_Allocate(arena, (size_t)capacity * sizeof(SimUndo), sizeof(uint64_t));
+    if (journal->moves == NULL)
+    {
+        return false;
+    }
+
+    journal->capacity = capacity;
+    return true;
+}
+
+/*
+ * Record the simulation's steps into a journal from now on
+ * The current state becomes the journal's base (move count 0); restarting
+ * or restoring the simulation later resets the journal to that new state.
+ *
+ * @param sim - Simulation to record
+ * @param journal - Journal to record into, or NULL to stop recording
+ */
+void Sim_AttachJournal(SimState* sim, SimJournal* journal)
+{
+    assert(sim != NULL);
+
+    sim->journal = journal;
+    if (journal != NULL)
+    {
+        journal->count = 0;
+        journal->isOverflowed = false;
+    }
+}
+
+/*
+ * Undo recorded moves, newest first, until moveCount moves remain
+ * Cost is constant per move undone, independent of the board size, and
+ * the state matches the one stepped from exactly, including food spawns.
+ *
+ * @param sim - Simulation with an attached journal
+ * @param moveCount - Journal count to rewind to (0 for the base state)
+ * @return true on success, false if the journal overflowed (the state is
+ *         left untouched; restore a snapshot instead)
+ */
+bool Sim_Rewind(SimState* sim, int moveCount)
+{
+    assert(sim != NULL);
+    assert(sim->journal != NULL);
+
+    SimJournal* journal = sim->journal;
+    assert(moveCount >= 0 && moveCount <= journal->count);
+
+    if (journal->isOverflowed)
+    {
+        return false;
+    }
+
+    while (journal->count > moveCount)
+    {
+        journal->count--;
+        Sim_UndoMove(sim, &journal->moves[journal->count]);
+    }
+
+    return true;
+}
@@ -1,14 +1,14 @@
 /*
  * snake.c
- * 
+ *
  * Snake entity management
- * Handles snake movement, input processing, collision detection, and rendering
- * 
+ * Handles snake movement, input processing, collision detection, and growth
+ *
  * Course: Advanced Programming Lab
  * Date: February 2026
  */
 
-#include "snake_game.h"
+#include "snake_sim.h"
 #include <assert.h>
 
 // ============================================================================
@@ -17,30 +17,28 @@
 
 /*
  * Initialize snake with starting position and configuration
- * 
+ * The body and occupancy arrays must already be bound to storage for
+ * capacity cells (see Sim_Create)
+ *
  * @param snake - Pointer to snake structure to initialize
- * @param startPosition - Initial position for snake head
- * @param gridOffset - Grid offset for proper positioning
+ * @param startCell - Initial grid cell for snake head
  */
-void Snake_Initialize(Snake* snake, Vector2 startPosition, Vector2 gridOffset)
+void Snake_Initialize(Snake* snake, int startCell)
 {
     assert(snake != NULL);
-    
+    assert(snake->body != NULL && snake->occupancy != NULL);
+    assert(startCell >= 0 && (uint32_t)startCell < snake->capacity);
+
     snake->length = 1;
-    snake->allowMove = false;
+    snake->headIndex = 0;
+    snake->body[0] = (uint32_t)startCell;
 
-    // Initialize all segments
-    for (int i = 0; i < MAX_SNAKE_LENGTH; i++)
-    {
-        snake->segments[i].position = (Vector2){ gridOffset.x, gridOffset.y };
-        snake->segments[i].size = (Vector2){ SQUARE_SIZE, SQUARE_SIZE };
-        snake->segments[i].speed = (Vector2){ SQUARE_SIZE, 0 };
-        
-        // Head is blue, body segments are sky blue
-        snake->segments[i].color = (i == 0) ? BLUE : SKYBLUE;
-        
-        snake->segmentPositions[i] = (Vector2){ 0.0f, 0.0f };
-    }
+    // Start moving right
+    snake->directionX = 1;
+    snake->directionY = 0;
+
+    // A lone head covers no body cells
+    Occupancy_ClearAll(snake->occupancy, (int)snake->capacity);
 }
 
 // ============================================================================
@@ -48,125 +46,122 @@ void Snake_Initialize(Snake* snake, Vector2 startPosition, Vector2 gridOffset)
 // ============================================================================
 
 /*
- * Process keyboard input for snake direction
- * Prevents 180-degree turns (moving directly backwards)
- * 
- * @param snake - Pointer to snake to control
+ * Check whether a direction request is a legal turn for the snake
+ * Rejects turns along the current axis (including 180-degree reversals)
+ *
+ * @param snake - Pointer to snake to check
+ * @param action - Requested direction
+ * @return true if the action would change the snake's direction
  */
-void Snake_ProcessInput(Snake* snake)
+bool Snake_CanApplyAction(const Snake* snake, SimAction action)
 {
     assert(snake != NULL);
-    
-    SnakeSegment* head = &snake->segments[0];
 
-    if (IsKeyPressed(KEY_RIGHT) && (head->speed.x == 0) && snake->allowMove)
+    switch (action)
     {
-        head->speed = (Vector2){ SQUARE_SIZE, 0 };
-        snake->allowMove = false;
+        case SIM_ACTION_LEFT:
+        case SIM_ACTION_RIGHT:
+            return snake->directionX == 0;
+        case SIM_ACTION_UP:
+        case SIM_ACTION_DOWN:
+            return snake->directionY == 0;
+        default:
+            return false;
     }
-    
-    if (IsKeyPressed(KEY_LEFT) && (head->speed.x == 0) && snake->allowMove)
-    {
-        head->speed = (Vector2){ -SQUARE_SIZE, 0 };
-        snake->allowMove = false;
-    }
-    
-    if (IsKeyPressed(KEY_UP) && (head->speed.y == 0) && snake->allowMove)
+}
+
+/*
+ * Apply a direction request to the snake
+ * Prevents 180-degree turns (moving directly backwards)
+ *
+ * @param snake - Pointer to snake to control
+ * @param action - Requested direction (SIM_ACTION_NONE keeps heading)
+ */
+void Snake_ProcessInput(Snake* snake, SimAction action)
+{
+    assert(snake != NULL);
+
+    if (!Snake_CanApplyAction(snake, action))
     {
-        head->speed = (Vector2){ 0, -SQUARE_SIZE };
-        snake->allowMove = false;
+        return;
     }
-    
-    if (IsKeyPressed(KEY_DOWN) && (head->speed.y == 0) && snake->allowMove)
+
+    switch (action)
     {
-        head->speed = (Vector2){ 0, SQUARE_SIZE };
-        snake->allowMove = false;
+        case SIM_ACTION_RIGHT: snake->directionX = 1;  snake->directionY = 0;  break;
+        case SIM_ACTION_LEFT:  snake->directionX = -1; snake->directionY = 0;  break;
+        case SIM_ACTION_UP:    snake->directionX = 0;  snake->directionY = -1; break;
+        case SIM_ACTION_DOWN:  snake->directionX = 0;  snake->directionY = 1;  break;
+        default: break;
     }
 }
 
 // ============================================================================
-// MOVEMENT AND POSITION UPDATE
+// SEGMENT ACCESS
 // ============================================================================
 
 /*
- * Update snake position based on current speed
- * Moves snake forward and updates all body segments
- * 
- * @param snake - Pointer to snake to update
- * @param framesCounter - Current frame count for timing
+ * Get the grid cell of a snake segment
+ *
+ * @param snake - Pointer to snake to query
+ * @param segmentIndex - Segment number, 0 for the head up to length - 1 for the tail
+ *                       (length gives the cell the tail vacated on the last move)
+ * @return Cell index occupied by that segment
  */
-void Snake_UpdatePosition(Snake* snake, int framesCounter)
+int Snake_GetSegmentCell(const Snake* snake, int segmentIndex)
 {
     assert(snake != NULL);
-    
-    // Store previous positions
-    for (int i = 0; i < snake->length; i++)
-    {
-        snake->segmentPositions[i] = snake->segments[i].position;
-    }
+    assert(segmentIndex >= 0 && (uint32_t)segmentIndex <= snake->length);
 
-    // Move snake every MOVE_FRAME_DELAY frames
-    if ((framesCounter % MOVE_FRAME_DELAY) == 0)
+    int slot = (int)snake->headIndex - segmentIndex;
+    if (slot < 0)
     {
-        for (int i = 0; i < snake->length; i++)
-        {
-            if (i == 0)
-            {
-                // Move head
-                snake->segments[0].position.x += snake->segments[0].speed.x;
-                snake->segments[0].position.y += snake->segments[0].speed.y;
-                snake->allowMove = true;
-            }
-            else
-            {
-                // Body segments follow the segment in front
-                snake->segments[i].position = snake->segmentPositions[i - 1];
-            }
-        }
+        slot += (int)snake->capacity;
     }
+
+    return snake->body[slot];
 }
 
 // ============================================================================
-// SCREEN WRAP-AROUND
+// MOVEMENT AND POSITION UPDATE
 // ============================================================================
 
 /*
- * Handle screen wrap-around (snake teleports to opposite side)
- * 
- * @param snake - Pointer to snake to check
- * @param gridOffset - Grid offset for boundary calculation
+ * Move snake one cell forward in its current direction
+ * Writes the new head into the next ring slot, so the tail advances
+ * without touching any other segment. Leaving the grid on one side
+ * wraps the head around to the opposite side.
+ *
+ * @param snake - Pointer to snake to update
  */
-void Snake_HandleWrapAround(Snake* snake, Vector2 gridOffset)
+void Snake_UpdatePosition(Snake* snake)
 {
     assert(snake != NULL);
-    
-    int cols = Utils_GetGridColumns();
+
+    int columns = Utils_GetGridColumns();
     int rows = Utils_GetGridRows();
-    
-    float minX = gridOffset.x;
-    float minY = gridOffset.y;
-    float maxX = gridOffset.x + (cols - 1) * SQUARE_SIZE;
-    float maxY = gridOffset.y + (rows - 1) * SQUARE_SIZE;
-
-    // Horizontal wrap-around
-    if (snake->segments[0].position.x > maxX)
-    {
-        snake->segments[0].position.x = minX;
-    }
-    else if (snake->segments[0].position.x < minX)
-    {
-        snake->segments[0].position.x = maxX;
-    }
+    int headCell = snake->body[snake->headIndex];
 
-    // Vertical wrap-around
-    if (snake->segments[0].position.y > maxY)
-    {
-        snake->segments[0].position.y = minY;
-    }
-    else if (snake->segments[0].position.y < minY)
+    // Step the head with wrap-around on both axes
+    int column = headCell % columns + snake->directionX;
+    int row = headCell / columns + snake->directionY;
+
+    if (column >= columns) column = 0;
+    else if (column < 0)   column = columns - 1;
+
+    if (row >= rows)   row = 0;
+    else if (row < 0)  row = rows - 1;
+
+    // Keep the body occupancy in sync: the tail cell is released and the
+    // cell the head is leaving becomes part of the body
+    if (snake->length > 1)
     {
-        snake->segments[0].position.y = maxY;
+        Occupancy_Release(snake->occupancy, Snake_GetSegmentCell(snake, (int)snake->length - 1));
+        Occupancy_Mark(snake->occupancy, headCell);
     }
+
+    snake->headIndex = (snake->headIndex + 1 < snake->capacity) ? snake->headIndex + 1 : 0;
+    snake->body[snake->headIndex] = (uint32_t)(row * columns + column);
 }
 
 // ============================================================================
@@ -175,24 +170,16 @@ void Snake_HandleWrapAround(Snake* snake, Vector2 gridOffset)
 
 /*
  * Check if snake head collides with its own body
- * 
+ * Single bit test against the body occupancy, independent of length
+ *
  * @param snake - Pointer to snake to check
  * @return true if collision detected, false otherwise
  */
 bool Snake_CheckSelfCollision(const Snake* snake)
 {
     assert(snake != NULL);
-    
-    for (int i = 1; i < snake->length; i++)
-    {
-        if ((snake->segments[0].position.x == snake->segments[i].position.x) &&
-            (snake->segments[0].position.y == snake->segments[i].position.y))
-        {
-            return true;
-        }
-    }
-    
-    return false;
+
+    return Occupancy_IsOccupied(snake->occupancy, snake->body[snake->headIndex]);
 }
 
 // ============================================================================
@@ -201,41 +188,20 @@ bool Snake_CheckSelfCollision(const Snake* snake)
 
 /*
  * Increase snake length by one segment
- * Called when snake eats food
- * 
+ * Called when snake eats food, right after a move. The ring slot behind
+ * the tail still holds the cell the tail just left, so growing simply
+ * takes back that tail advance.
+ *
  * @param snake - Pointer to snake to grow
  */
 void Snake_Grow(Snake* snake)
 {
     assert(snake != NULL);
-    assert(snake->length < MAX_SNAKE_LENGTH);
-    
-    if (snake->length < MAX_SNAKE_LENGTH)
-    {
-        snake->segments[snake->length].position = snake->segmentPositions[snake->length - 1];
-        snake->length++;
-    }
-}
+    assert(snake->length < snake->capacity);
 
-// ============================================================================
-// RENDERING
-// ============================================================================
-
-/*
- * Draw snake to screen
- * 
- * @param snake - Pointer to snake to render
- */
-void Snake_Render(const Snake* snake)
-{
-    assert(snake != NULL);
-    
-    for (int i = 0; i < snake->length; i++)
+    if (snake->length < snake->capacity)
     {
-        DrawRectangleV(
-            snake->segments[i].position,
-            snake->segments[i].size,
-            snake->segments[i].color
-        );
+        Occupancy_Mark(snake->occupancy, Snake_GetSegmentCell(snake, (int)snake->length));
+        snake->length++;
     }
 }
@@ -12,128 +12,152 @@
 #define SNAKE_GAME_H
 
 #include "raylib.h"
+#include "snake_sim.h"
 #include <stdbool.h>
 
 // ============================================================================
 // GAME CONFIGURATION CONSTANTS
 // ============================================================================
 
-#define MAX_SNAKE_LENGTH   400
-#define SQUARE_SIZE        31
-#define SCREEN_WIDTH       800
-#define SCREEN_HEIGHT      450
-#define TARGET_FPS         30
-#define MOVE_FRAME_DELAY   5
-#define FREEZE_DURATION    60  // Frames to freeze before game over
+#define TICK_RATE          6.0   // Snake moves per second, independent of frame rate
+#define TICK_SECONDS       (1.0 / TICK_RATE)
+#define MAX_FRAME_SECONDS  0.25  // Longest frame fed to the tick accumulator
+#define FALLBACK_FPS       60    // Frame cap when the monitor rate is unknown
+#define FREEZE_DURATION    12    // Ticks to freeze before game over
+#define GRID_LINES_MIN_CELL 4    // Smaller cells are drawn without grid lines
+#define MATCH_MAX_PLAYERS  2     // Local players in a multi-snake match (arrows, WASD)
+#define PROFILE_CSV_PATH   "snake_profile.csv"  // Profiler summary written on exit
 
 // ============================================================================
 // TYPE DEFINITIONS
 // ============================================================================
 
 /*
- * Position in 2D space
- */
-typedef struct {
-    float x;
-    float y;
-} Position;
-
-/*
- * Represents a single segment of the snake
- */
-typedef struct {
-    Vector2 position;
-    Vector2 size;
-    Vector2 speed;
-    Color color;
-} SnakeSegment;
-
-/*
- * Represents the food/fruit in the game
+ * Game state and configuration
+ * Wraps the headless simulation with tick timing and UI flow
  */
 typedef struct {
-    Vector2 position;
-    Vector2 size;
-    bool active;
-    Color color;
-} Food;
+    SimState sim;
+    uint64_t seed;
+    InputQueue input;
+
+    // Picks every move of the single-snake game: the keyboard, or a
+    // built-in bot when hasBot is set (the tree search player if hasMcts
+    // is set too)
+    Controller controller;
+    bool hasBot;
+    ControllerBot bot;
+    bool hasMcts;
+    int mctsBudgetMicroseconds;
+    ThreadPool* mctsPool;
+    MctsAgent mcts;
+
+    // Distances to the food for the path hint (single-snake game only)
+    PathField pathHint;
+
+    // Memory of the simulation and the replay; a restart rolls the
+    // arena back to roundMark, just past the simulation
+    Arena arena;
+    ArenaMark roundMark;
+
+    Position gridOffset;
+    bool isGameOver;
+    bool isPaused;
+    int freezeCounter;
 
-/*
- * Complete snake entity with all segments
- */
-typedef struct {
-    SnakeSegment segments[MAX_SNAKE_LENGTH];
-    Vector2 segmentPositions[MAX_SNAKE_LENGTH];
-    int length;
-    bool allowMove;
-} Snake;
+    // What the last tick did, for interpolated rendering
+    bool movedOnLastTick;
+    bool grewOnLastTick;
+
+    // Rendering options
+    bool useFullRedraw;
+    bool showFrameTime;
+    bool showProfiler;
+    bool showPathHint;
+    double drawMilliseconds;
+
+    // Input-to-visible-turn latency
+    bool isTurnPending;
+    double turnPressTime;
+    double inputLatencyMilliseconds;
+    double inputLatencyAverage;
+    double inputLatencyMax;
+
+    // Multi-snake match: the first matchPlayerCount snakes are local
+    // players, the rest are bots; replaces sim when isMatch is set
+    bool isMatch;
+    int matchSnakeCount;
+    int matchPlayerCount;
+    MatchState match;
+    SimAction* matchActions;
+    InputQueue playerInput[MATCH_MAX_PLAYERS];
+
+    // Replay: recorded while playing, or the game being played back
+    Replay replay;
+    ReplayCursor playback;
+    const char* recordPath;
+    bool isPlayback;
+    float playbackRate;
+    float playbackBudget;
+} GameState;
 
 /*
- * Game state and configuration
+ * Copy of the game state (see Game_Snapshot)
  */
 typedef struct {
-    int framesCounter;
-    int playerScore;
+    SimSnapshot sim;
+    InputQueue input;
+    int freezeCounter;
     bool isGameOver;
     bool isPaused;
-    int freezeCounter;
-    Vector2 gridOffset;
-} GameState;
+    uint64_t seed;
+    size_t replaySize;
+    int replayLastTick;
+    ReplayCursor playback;
+} GameSnapshot;
 
 // ============================================================================
 // CORE GAME FUNCTIONS
 // ============================================================================
 
-void Game_Initialize(void);
+bool Game_Initialize(uint64_t seed);
 void Game_Update(void);
-void Game_Render(void);
+void Game_Tick(void);
+void Game_Render(float alpha);
 void Game_Cleanup(void);
-void Game_UpdateAndDraw(void);
-
-// ============================================================================
-// SNAKE MODULE FUNCTIONS
-// ============================================================================
-
-void Snake_Initialize(Snake* snake, Vector2 startPosition, Vector2 gridOffset);
-void Snake_UpdatePosition(Snake* snake, int framesCounter);
-void Snake_ProcessInput(Snake* snake);
-void Snake_HandleWrapAround(Snake* snake, Vector2 gridOffset);
-bool Snake_CheckSelfCollision(const Snake* snake);
-void Snake_Grow(Snake* snake);
-void Snake_Render(const Snake* snake);
-
-// ============================================================================
-// FOOD MODULE FUNCTIONS
-// ============================================================================
-
-void Food_Initialize(Food* food);
-void Food_Spawn(Food* food, const Snake* snake, Vector2 gridOffset);
-bool Food_CheckCollision(const Food* food, Vector2 position);
-void Food_Render(const Food* food);
-
-// ============================================================================
-// COLLISION MODULE FUNCTIONS
-// ============================================================================
-
-bool Collision_CheckSnakeWithFood(const Snake* snake, const Food* food);
-bool Collision_CheckSnakeWithSelf(const Snake* snake);
+void Game_SetRecordPath(const char* path);
+void Game_SetMatchMode(int snakeCount, int playerCount);
+void Game_SetBot(ControllerBot bot);
+void Game_SetMcts(int budgetMicroseconds, ThreadPool* pool);
+bool Game_StartPlayback(const char* path, float rate);
+void Game_Snapshot(GameSnapshot* snapshot);
+void Game_Restore(const GameSnapshot* snapshot);
+bool Game_IsOver(void);
+double Game_GetDrawTime(void);
+double Game_GetInputLatency(void);
 
 // ============================================================================
 // RENDERING MODULE FUNCTIONS
 // ============================================================================
 
-void Renderer_DrawGrid(Vector2 gridOffset);
+void Renderer_Initialize(Position gridOffset);
+void Renderer_Cleanup(void);
+void Renderer_DrawGrid(Position gridOffset);
+void Renderer_InvalidateBoard(void);
+void Renderer_UpdateBoard(const Snake* snake, const Food* food, Position gridOffset);
+void Renderer_DrawBoard(const Snake* snake, const Food* food, Position gridOffset);
+void Snake_RenderBody(const Snake* snake, Position gridOffset);
+void Snake_RenderMotion(const Snake* snake, Position gridOffset, float alpha, bool tailMoved);
+void Snake_Render(const Snake* snake, Position gridOffset, float alpha, bool tailMoved);
+void Food_Render(const Food* food, Position gridOffset);
+void Renderer_DrawPathHint(const PathField* field, const Snake* snake, Position gridOffset);
+void Renderer_DrawMatch(const MatchState* match, Position gridOffset, int playerCount);
+void Renderer_DrawMatchScores(const MatchState* match, int playerCount);
 void Renderer_DrawGameOver(int finalScore);
 void Renderer_DrawPauseScreen(void);
 void Renderer_DrawFreezeEffect(void);
-
-// ============================================================================
-// UTILITY FUNCTIONS
-// ============================================================================
-
-int Utils_GetGridColumns(void);
-int Utils_GetGridRows(void);
-Vector2 Utils_CalculateGridOffset(void);
-bool Utils_IsPositionValid(Vector2 position, Vector2 gridOffset);
+void Renderer_DrawFrameTime(float frameMilliseconds, double drawMilliseconds);
+void Renderer_DrawInputLatency(double lastMilliseconds, double averageMilliseconds, double maxMilliseconds);
+void Renderer_DrawProfiler(void);
 
 #endif // SNAKE_GAME_H
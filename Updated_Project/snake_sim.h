@@ -0,0 +1,750 @@
+/*
+ * snake_sim.h
+ *
+ * Headless simulation core for Snake Game
+ * Contains the pure game-logic types and functions with no raylib dependency,
+ * so the game can be stepped on machines without a window or GPU context
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#ifndef SNAKE_SIM_H
+#define SNAKE_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// SIMULATION CONFIGURATION CONSTANTS
+// ============================================================================
+
+#define SQUARE_SIZE        31      // Largest cell size; big boards shrink cells to fit
+#define SCREEN_WIDTH       800
+#define SCREEN_HEIGHT      450
+
+#define DEFAULT_GRID_COLUMNS (SCREEN_WIDTH / SQUARE_SIZE)
+#define DEFAULT_GRID_ROWS    (SCREEN_HEIGHT / SQUARE_SIZE)
+#define BOARD_MIN_SIZE     2       // Smallest board side in cells
+#define BOARD_MAX_SIZE     4096    // Largest board side in cells
+#define BATCH_NO_FOOD      0xFFFF  // Batch food cell when the board is full
+#define INPUT_QUEUE_CAPACITY 3     // Turns buffered ahead of the next move
+#define PROFILE_BUCKETS    256     // Log-scale histogram buckets per phase
+#define ARENA_BLOCK_SIZE   (64 * 1024) // Default arena block in bytes
+#define MATCH_MAX_SNAKES   4096    // Snakes sharing one multi-snake board
+#define MATCH_CELL_EMPTY   0       // Match cell owner: nothing on the cell
+#define MATCH_CELL_FOOD    0xFFFF  // Match cell owner: food (snakes are 1 + index)
+#define MATCH_RESPAWN_TICKS 12     // Default ticks a dead match snake waits
+#define MCTS_DEFAULT_BUDGET_US 2000 // Default tree search time per move
+#define PATH_UNREACHABLE   UINT32_MAX  // Distance of body cells and cells cut off from the food
+
+// Cells and ring slots are stored as uint32_t
+#if (BOARD_MAX_SIZE > 65535)
+#error "Board too large for 32-bit cell indices"
+#endif
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/*
+ * Per-instance random number generator state (PCG32)
+ */
+typedef struct {
+    uint64_t state;
+} Rng;
+
+/*
+ * Bump allocator owning the memory of one game or batch
+ * Memory comes from a chain of blocks that is kept across resets, so a
+ * reset is O(1) and a restarted game reuses the same addresses. A
+ * zeroed Arena is empty and valid; nothing is freed until Arena_Destroy.
+ */
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock* first;
+    ArenaBlock* current;
+    size_t used;
+    size_t blockSize;
+} Arena;
+
+/*
+ * Arena position to roll back to; later allocations are dropped
+ */
+typedef struct {
+    ArenaBlock* block;
+    size_t used;
+} ArenaMark;
+
+/*
+ * Position in 2D space
+ */
+typedef struct {
+    float x;
+    float y;
+} Position;
+
+/*
+ * Represents the food/fruit in the game
+ * Stored as a grid cell; screen position and color are derived at render time
+ */
+typedef struct {
+    uint32_t cell;
+    bool active;
+} Food;
+
+/*
+ * Complete snake entity with all segments
+ * The body is a ring buffer of cell indices: body[headIndex] is the head
+ * and each following segment sits one slot further back. A move writes
+ * the new head into the next slot, which implicitly advances the tail.
+ * The occupancy bitset has one bit per grid cell covered by the body
+ * (every segment except the head), kept in sync on each move.
+ * Both arrays are sized to the board by Sim_Create (the ring has one
+ * slot more than the board), so the snake can grow to cover every cell.
+ * Only the head carries a direction.
+ */
+typedef struct {
+    uint32_t* body;
+    uint64_t* occupancy;
+    uint32_t capacity;
+    uint32_t headIndex;
+    uint32_t length;
+    int8_t directionX;
+    int8_t directionY;
+} Snake;
+
+/*
+ * Set of grid cells not covered by the snake
+ * cells[0..count) lists the free cells in no particular order and
+ * slotOf[cell] gives a free cell's position in that list
+ * Both arrays hold one entry per board cell
+ */
+typedef struct {
+    uint32_t* cells;
+    uint32_t* slotOf;
+    int count;
+} FreeCellSet;
+
+/*
+ * Direction request applied to the snake on a simulation step
+ */
+typedef enum {
+    SIM_ACTION_NONE = 0,
+    SIM_ACTION_UP,
+    SIM_ACTION_DOWN,
+    SIM_ACTION_LEFT,
+    SIM_ACTION_RIGHT
+} SimAction;
+
+/*
+ * Bounded FIFO of validated turns waiting for the next moves
+ * Timestamps are opaque to the queue (the caller's clock at the key press)
+ */
+typedef struct {
+    uint8_t actions[INPUT_QUEUE_CAPACITY];
+    double timestamps[INPUT_QUEUE_CAPACITY];
+    int head;
+    int count;
+} InputQueue;
+
+/*
+ * Events reported by Sim_Step (combined as bit flags)
+ */
+typedef enum {
+    SIM_EVENT_NONE = 0,
+    SIM_EVENT_ATE  = 1 << 0,
+    SIM_EVENT_DIED = 1 << 1
+} SimEvent;
+
+/*
+ * What one Sim_Step changed, enough to take the move back (see sim.c)
+ */
+typedef struct {
+    uint64_t rngState;
+    uint32_t tailCell;        // Tail before the move
+    uint32_t overwrittenCell; // Ring slot the new head was written into
+    uint32_t headSlot;        // Free-list slot the new head was taken from
+    uint32_t tailSlot;        // Free-list slot the tail was taken from on eating
+    uint32_t foodCell;
+    uint8_t flags;            // SIM_UNDO_* bits (sim.c)
+    int8_t directionX;
+    int8_t directionY;
+} SimUndo;
+
+/*
+ * Moves stepped since a base state, undone newest first by Sim_Rewind
+ * A search steps forward from its root and rewinds instead of copying the
+ * whole board back. The move buffer comes from an arena; once it is full
+ * the journal is marked overflowed and can no longer rewind.
+ */
+typedef struct {
+    SimUndo* moves;
+    int capacity;
+    int count;
+    bool isOverflowed;
+} SimJournal;
+
+/*
+ * Complete simulation state for one game
+ * The random stream lives in the state, so a seed fully determines a game
+ * and separate games never share generator state.
+ * The snake and free-cell arrays live in one block, taken from an arena
+ * and sized to the board the state was created for (see Sim_Create).
+ */
+typedef struct {
+    Snake snake;
+    Food food;
+    FreeCellSet freeCells;
+    Rng rng;
+    uint64_t seed;
+    int score;
+    int tickCount;
+    bool isDead;
+
+    // Sim_Step feeds the profiler (the default); copies stepped by
+    // searches, possibly on other threads, turn this off
+    bool isProfiled;
+
+    // Records every step for Sim_Rewind when set (see Sim_AttachJournal)
+    SimJournal* journal;
+
+    int cellCount;
+    void* storage;
+    size_t storageSize;
+} SimState;
+
+/*
+ * Distance from every cell to the food around the body (see path.c)
+ * Kept up to date move by move: only the cells whose distance depends on
+ * the new head, the vacated tail or a food cell that moved are revisited.
+ * Only a new game or a restored snapshot needs a full rebuild. The
+ * buffers come from an arena, sized to the board by Path_Create.
+ */
+typedef struct {
+    int columns;
+    int rows;
+    int cellCount;
+    uint32_t* distance;
+    uint8_t* flags;
+    uint32_t* queue;
+    uint32_t* affected;
+
+    // Bucket queue of repaired cells keyed by distance: first cell of each
+    // distance and the next cell in the same bucket
+    uint32_t* bucketHead;
+    uint32_t* bucketNext;
+
+    // Game position the field is up to date with
+    bool isCurrent;
+    uint64_t seed;
+    int tickCount;
+    uint32_t headCell;
+    uint32_t length;
+    bool hasFood;
+    uint32_t foodCell;
+
+    // Distances written by the last Path_Update
+    int changedCount;
+} PathField;
+
+/*
+ * Built-in autopilots (see controller.c)
+ */
+typedef enum {
+    CONTROLLER_BOT_GREEDY = 0,
+    CONTROLLER_BOT_PATH,
+    CONTROLLER_BOT_CYCLE,
+    CONTROLLER_BOT_COUNT
+} ControllerBot;
+
+/*
+ * Source of the action for each move: the keyboard, a built-in bot or
+ * anything else that implements decide. decide is called once per move
+ * with the game about to be stepped. The built-in bots keep their search
+ * buffers here, taken from an arena and sized to the board by
+ * Controller_CreateBot, so a decision never allocates; other controllers
+ * keep their state behind context.
+ */
+typedef struct Controller Controller;
+typedef SimAction (*ControllerDecideFunc)(Controller* controller, const SimState* sim);
+
+struct Controller {
+    ControllerDecideFunc decide;
+    void* context;
+    int columns;
+    int rows;
+    int cellCount;
+
+    // Search: queue, parent links, moves to each reached cell and
+    // generation-stamped visit and block marks (a cell is marked when its
+    // stamp equals the generation)
+    uint32_t* queue;
+    uint32_t* parent;
+    uint32_t* searchDistance;
+    uint32_t* visitStamp;
+    uint32_t* blockStamp;
+    uint32_t* blockedUntil;
+    uint32_t visitGeneration;
+    uint32_t blockGeneration;
+
+    // Length and tick of the path bot's last meal, to notice when it has
+    // been circling for a whole board's worth of moves
+    uint32_t mealLength;
+    int mealTick;
+
+    // Hamiltonian cycle: successor and position of every cell
+    uint32_t* cycleNext;
+    uint32_t* cycleIndex;
+};
+
+/*
+ * Compact copy of a SimState for rollback and tree search
+ * Holds only what cannot be rebuilt: the body cells (head first) followed
+ * by the free cells in free-list order, so cells[] covers the board exactly
+ * once. The cell buffer is taken from an arena by Sim_CreateSnapshot for
+ * one board size and reused by every Sim_Snapshot into it; cells are stored
+ * in 2 bytes on boards of up to 65535 cells and in 4 bytes above that.
+ */
+typedef struct {
+    uint64_t rngState;
+    uint64_t seed;
+    int32_t score;
+    int32_t tickCount;
+    int32_t cellCount;
+    uint32_t length;
+    uint32_t freeCount;
+    uint32_t foodCell;
+    uint8_t foodActive;
+    uint8_t isDead;
+    int8_t directionX;
+    int8_t directionY;
+    uint8_t cellBytes;
+    void* cells;
+} SimSnapshot;
+
+/*
+ * Recorded game: the seed and board size plus the encoded turn stream
+ * (see replay.c). tickCount is valid once the recording is finished.
+ * The turn stream grows inside arena, or on the heap when arena is NULL
+ */
+typedef struct {
+    Arena* arena;
+    uint64_t seed;
+    int columns;
+    int rows;
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    int lastTick;
+    int tickCount;
+    bool isFinished;
+} Replay;
+
+/*
+ * Read position while playing a replay back
+ */
+typedef struct {
+    const Replay* replay;
+    size_t offset;
+    int nextTick;
+    bool clockwise;
+} ReplayCursor;
+
+/*
+ * Phases timed by the profiler
+ * Movement includes the wrap-around step and the free-cell bookkeeping
+ */
+typedef enum {
+    PROFILE_INPUT = 0,
+    PROFILE_TICK,
+    PROFILE_MOVEMENT,
+    PROFILE_COLLISION,
+    PROFILE_FOOD_SPAWN,
+    PROFILE_RENDER_BOARD,
+    PROFILE_RENDER_SNAKE,
+    PROFILE_RENDER_OVERLAY,
+    PROFILE_RENDER_PRESENT,
+    PROFILE_FRAME,
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+/*
+ * Per-frame time spent in one phase, over every frame it ran in
+ */
+typedef struct {
+    uint64_t samples;
+    double meanMicroseconds;
+    double p50Microseconds;
+    double p99Microseconds;
+    double maxMicroseconds;
+} ProfileStats;
+
+/*
+ * Work-stealing thread pool (opaque) and the loop body it runs
+ */
+typedef struct ThreadPool ThreadPool;
+typedef void (*ThreadPoolTask)(void* context, int begin, int end);
+
+/*
+ * Monte Carlo tree search player (see mcts.c)
+ * Runs playouts on copies of the live game until the move's time budget
+ * is spent. With a thread pool every worker grows its own tree (root
+ * parallelism) and the trees vote with their root visit counts. Trees,
+ * node pools and scratch games come from an arena, sized to the board
+ * once by Mcts_Create.
+ */
+typedef struct MctsTree MctsTree;
+
+typedef struct {
+    MctsTree** trees;
+    int treeCount;
+    ThreadPool* pool;
+    int budgetMicroseconds;
+    int horizon;                // Moves a playout looks ahead of the live game
+    int columns;
+    int rows;
+    uint64_t decisionCount;     // Seeds each decision's playouts
+
+    // Set for the duration of a decision
+    const SimState* root;
+    uint64_t deadlineNs;
+
+    // Playouts run by every tree for the last decision
+    int lastPlayoutCount;
+} MctsAgent;
+
+/*
+ * Cell codes written into batch observation planes
+ */
+typedef enum {
+    OBS_EMPTY = 0,
+    OBS_BODY  = 1,
+    OBS_HEAD  = 2,
+    OBS_FOOD  = 3
+} ObservationCell;
+
+/*
+ * Planes written by the observation encoder, in channel order
+ * HEAD and FOOD are one-hot; BODY holds each segment's remaining life,
+ * (length - age) / length, so the neck is brightest and the tail fades
+ */
+typedef enum {
+    OBS_CHANNEL_HEAD = 0,
+    OBS_CHANNEL_BODY,
+    OBS_CHANNEL_FOOD,
+    OBS_CHANNEL_COUNT
+} ObservationChannel;
+
+/*
+ * Element type of an encoded observation buffer
+ * U8 planes scale 1.0 to 255
+ */
+typedef enum {
+    OBS_FORMAT_U8 = 0,
+    OBS_FORMAT_F32
+} ObservationFormat;
+
+/*
+ * Observation encoder implementations, slowest first
+ */
+typedef enum {
+    OBS_KERNEL_SCALAR = 0,
+    OBS_KERNEL_SSE2,
+    OBS_KERNEL_AVX2,
+    OBS_KERNEL_COUNT
+} ObservationKernel;
+
+/*
+ * Many independent games stored as structure-of-arrays
+ * Per-game scalars live in arrays indexed by game; per-game grids
+ * (ring body, observation) are slabs of cellCount entries per game and
+ * the body occupancy bitset takes occupancyWords per game. cellSlot is
+ * the inverse of the ring: the slot a body cell was entered at, so a
+ * segment's age is ringHead - cellSlot (mod cellCount).
+ * Games that die are reset automatically inside Batch_Step.
+ * Each game owns its random stream, so results do not depend on how
+ * games are split across threads. Every array lives in the batch's
+ * own arena, allocated once by Batch_Create.
+ */
+typedef struct {
+    Arena arena;
+    int gameCount;
+    int columns;
+    int rows;
+    int cellCount;
+    int occupancyWords;
+
+    uint16_t* headX;
+    uint16_t* headY;
+    int8_t* directionX;
+    int8_t* directionY;
+    uint16_t* ringHead;
+    uint16_t* length;
+    uint16_t* foodCell;
+    int32_t* score;
+    uint8_t* events;
+    Rng* rng;
+
+    uint16_t* body;
+    uint16_t* cellSlot;
+    uint64_t* occupancy;
+    uint8_t* observations;
+} SnakeBatch;
+
+/*
+ * One snake of a multi-snake match
+ * The body is threaded through the match's nextCell links from tailCell
+ * to headCell, so a snake needs no storage of its own. events holds the
+ * SimEvent flags raised on the last tick.
+ */
+typedef struct {
+    uint32_t headCell;
+    uint32_t tailCell;
+    uint32_t length;
+    int8_t directionX;
+    int8_t directionY;
+    bool isAlive;
+    uint8_t events;
+    int score;
+    int respawnCountdown;
+} MatchSnake;
+
+/*
+ * Many snakes sharing one board
+ * owner[] is the shared cell-ownership grid: MATCH_CELL_EMPTY, 1 + the
+ * index of the snake covering the cell, or MATCH_CELL_FOOD. A head looks
+ * up the one cell it enters, so collisions cost O(snakes) per tick no
+ * matter how long the snakes are. claim[] is per-tick scratch that finds
+ * heads entering the same cell and is all zero between ticks. Free cells
+ * hold neither a snake nor food. Dead snakes come back after
+ * respawnTicks ticks (0 keeps them dead).
+ */
+typedef struct {
+    int snakeCount;
+    int foodCount;
+    int respawnTicks;
+    int cellCount;
+    int tickCount;
+    int aliveCount;
+    uint64_t seed;
+    Rng rng;
+
+    MatchSnake* snakes;
+    Food* foods;
+    uint16_t* owner;
+    uint32_t* nextCell;
+    uint16_t* claim;
+    uint32_t* targetCell;
+    FreeCellSet freeCells;
+} MatchState;
+
+// ============================================================================
+// ARENA FUNCTIONS
+// ============================================================================
+
+void Arena_Initialize(Arena* arena, size_t blockSize);
+void Arena_Destroy(Arena* arena);
+void* Arena_Allocate(Arena* arena, size_t size, size_t alignment);
+void* Arena_Resize(Arena* arena, void* memory, size_t oldSize, size_t newSize, size_t alignment);
+void Arena_Reset(Arena* arena);
+ArenaMark Arena_GetMark(const Arena* arena);
+void Arena_ResetToMark(Arena* arena, ArenaMark mark);
+size_t Arena_GetReservedSize(const Arena* arena);
+
+// ============================================================================
+// SIMULATION FUNCTIONS
+// ============================================================================
+
+bool Sim_Create(SimState* sim, Arena* arena);
+void Sim_Initialize(SimState* sim, uint64_t seed);
+int Sim_Step(SimState* sim, SimAction action);
+void Sim_Copy(SimState* destination, const SimState* source);
+bool Sim_CreateSnapshot(SimSnapshot* snapshot, int cellCount, Arena* arena);
+void Sim_Snapshot(const SimState* sim, SimSnapshot* snapshot);
+void Sim_Restore(SimState* sim, const SimSnapshot* snapshot);
+size_t Sim_GetSnapshotSize(const SimSnapshot* snapshot);
+bool Sim_CreateJournal(SimJournal* journal, int capacity, Arena* arena);
+void Sim_AttachJournal(SimState* sim, SimJournal* journal);
+bool Sim_Rewind(SimState* sim, int moveCount);
+
+// ============================================================================
+// REPLAY FUNCTIONS
+// ============================================================================
+
+void Replay_Initialize(Replay* replay, Arena* arena);
+void Replay_Destroy(Replay* replay);
+void Replay_Begin(Replay* replay, uint64_t seed);
+bool Replay_RecordAction(Replay* replay, int tick, const Snake* snake, SimAction action);
+bool Replay_Finish(Replay* replay, int tickCount);
+bool Replay_Save(const Replay* replay, const char* path);
+bool Replay_Load(Replay* replay, const char* path);
+void Replay_BeginPlayback(ReplayCursor* cursor, const Replay* replay);
+SimAction Replay_NextAction(ReplayCursor* cursor, int tick, const Snake* snake);
+bool Replay_Simulate(const Replay* replay, SimState* sim);
+
+// ============================================================================
+// CONTROLLER FUNCTIONS
+// ============================================================================
+
+void Controller_Initialize(Controller* controller, ControllerDecideFunc decide, void* context);
+bool Controller_CreateBot(Controller* controller, ControllerBot bot, Arena* arena);
+SimAction Controller_Decide(Controller* controller, const SimState* sim);
+const char* Controller_GetBotName(ControllerBot bot);
+
+// ============================================================================
+// DISTANCE FIELD FUNCTIONS
+// ============================================================================
+
+bool Path_Create(PathField* field, Arena* arena);
+void Path_Update(PathField* field, const SimState* sim);
+uint32_t Path_DistanceToFood(const PathField* field, int cell);
+int Path_GetStep(const PathField* field, int cell);
+
+// ============================================================================
+// MONTE CARLO TREE SEARCH FUNCTIONS
+// ============================================================================
+
+bool Mcts_Create(MctsAgent* agent, Arena* arena, int budgetMicroseconds, ThreadPool* pool);
+SimAction Mcts_Decide(MctsAgent* agent, const SimState* sim);
+void Mcts_AttachController(Controller* controller, MctsAgent* agent);
+
+// ============================================================================
+// BATCH SIMULATION FUNCTIONS
+// ============================================================================
+
+bool Batch_Create(SnakeBatch* batch, int gameCount, int columns, int rows, uint64_t seed);
+void Batch_Destroy(SnakeBatch* batch);
+void Batch_Reset(SnakeBatch* batch);
+void Batch_ResetGame(SnakeBatch* batch, int game);
+void Batch_Step(SnakeBatch* batch, const uint8_t* actions);
+void Batch_StepParallel(SnakeBatch* batch, const uint8_t* actions, ThreadPool* pool);
+const uint8_t* Batch_GetObservation(const SnakeBatch* batch, int game);
+
+// ============================================================================
+// OBSERVATION ENCODER FUNCTIONS
+// ============================================================================
+
+size_t Observation_GetBatchSize(const SnakeBatch* batch, ObservationFormat format);
+void Observation_EncodeBatch(const SnakeBatch* batch, void* out, ObservationFormat format);
+void Observation_EncodeBatchParallel(const SnakeBatch* batch, void* out, ObservationFormat format,
+                                     ThreadPool* pool);
+ObservationKernel Observation_GetKernel(void);
+bool Observation_IsKernelSupported(ObservationKernel kernel);
+bool Observation_SetKernel(ObservationKernel kernel);
+const char* Observation_GetKernelName(ObservationKernel kernel);
+
+// ============================================================================
+// MULTI-SNAKE MATCH FUNCTIONS
+// ============================================================================
+
+bool Match_Create(MatchState* match, Arena* arena, int snakeCount, int foodCount);
+void Match_Initialize(MatchState* match, uint64_t seed);
+int Match_Step(MatchState* match, const SimAction* actions);
+SimAction Match_ChooseBotAction(const MatchState* match, int snakeIndex);
+
+// ============================================================================
+// THREAD POOL FUNCTIONS
+// ============================================================================
+
+ThreadPool* ThreadPool_Create(int threadCount);
+void ThreadPool_Destroy(ThreadPool* pool);
+int ThreadPool_GetThreadCount(const ThreadPool* pool);
+void ThreadPool_ParallelFor(ThreadPool* pool, int itemCount, int chunkSize,
+                            ThreadPoolTask task, void* context);
+
+// ============================================================================
+// PROFILER FUNCTIONS
+// ============================================================================
+
+void Profiler_SetEnabled(bool enabled);
+bool Profiler_IsEnabled(void);
+void Profiler_Reset(void);
+uint64_t Profiler_Begin(void);
+uint64_t Profiler_End(ProfilePhase phase, uint64_t start);
+void Profiler_EndFrame(void);
+const char* Profiler_GetPhaseName(ProfilePhase phase);
+void Profiler_GetStats(ProfilePhase phase, ProfileStats* stats);
+bool Profiler_WriteCsv(const char* path);
+
+// ============================================================================
+// INPUT QUEUE FUNCTIONS
+// ============================================================================
+
+void InputQueue_Clear(InputQueue* queue);
+bool InputQueue_Push(InputQueue* queue, bool isMovingHorizontally, SimAction action, double timestamp);
+SimAction InputQueue_Pop(InputQueue* queue, double* timestamp);
+
+// ============================================================================
+// SNAKE MODULE FUNCTIONS
+// ============================================================================
+
+void Snake_Initialize(Snake* snake, int startCell);
+void Snake_UpdatePosition(Snake* snake);
+bool Snake_CanApplyAction(const Snake* snake, SimAction action);
+void Snake_ProcessInput(Snake* snake, SimAction action);
+int Snake_GetSegmentCell(const Snake* snake, int segmentIndex);
+bool Snake_CheckSelfCollision(const Snake* snake);
+void Snake_Grow(Snake* snake);
+
+// ============================================================================
+// OCCUPANCY BITSET FUNCTIONS
+// ============================================================================
+
+void Occupancy_ClearAll(uint64_t* bits, int cellCount);
+void Occupancy_Mark(uint64_t* bits, int cell);
+void Occupancy_Release(uint64_t* bits, int cell);
+bool Occupancy_IsOccupied(const uint64_t* bits, int cell);
+
+// ============================================================================
+// FREE-CELL INDEX FUNCTIONS
+// ============================================================================
+
+void FreeCells_Initialize(FreeCellSet* set, int cellCount);
+bool FreeCells_Contains(const FreeCellSet* set, int cell);
+void FreeCells_Add(FreeCellSet* set, int cell);
+void FreeCells_Remove(FreeCellSet* set, int cell);
+void FreeCells_UndoAdd(FreeCellSet* set);
+void FreeCells_UndoRemove(FreeCellSet* set, int cell, int slot);
+
+// ============================================================================
+// FOOD MODULE FUNCTIONS
+// ============================================================================
+
+void Food_Initialize(Food* food);
+void Food_Spawn(Food* food, const FreeCellSet* freeCells, Rng* rng);
+bool Food_CheckCollision(const Food* food, int cell);
+
+// ============================================================================
+// COLLISION MODULE FUNCTIONS
+// ============================================================================
+
+bool Collision_CheckSnakeWithFood(const Snake* snake, const Food* food);
+bool Collision_CheckSnakeWithSelf(const Snake* snake);
+
+// ============================================================================
+// RANDOM NUMBER FUNCTIONS
+// ============================================================================
+
+void Rng_Seed(Rng* rng, uint64_t seed, uint64_t stream);
+uint32_t Rng_Next(Rng* rng);
+uint32_t Rng_NextBounded(Rng* rng, uint32_t bound);
+
+// ============================================================================
+// UTILITY FUNCTIONS
+// ============================================================================
+
+bool Utils_SetBoardSize(int columns, int rows);
+int Utils_GetGridColumns(void);
+int Utils_GetGridRows(void);
+int Utils_GetCellCount(void);
+int Utils_GetCellSize(void);
+Position Utils_CalculateGridOffset(void);
+bool Utils_IsPositionValid(Position position, Position gridOffset);
+int Utils_GetCellIndex(Position position, Position gridOffset);
+Position Utils_GetCellPosition(int cell, Position gridOffset);
+void Utils_GetNeighborCells(int columns, int cellCount, uint32_t cell, uint32_t neighbors[4]);
+
+#endif // SNAKE_SIM_H
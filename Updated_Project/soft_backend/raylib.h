@@ -0,0 +1,115 @@
+/*
+ * raylib.h (software backend)
+ *
+ * Stand-in for the raylib header used by the headless build
+ * Declares the types and calls main.c, game.c and renderer.c use; the
+ * matching raylib_soft.c draws them into an RGBA buffer in memory, so
+ * frames can be rendered and saved on machines without a display or GPU
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#ifndef RAYLIB_H
+#define RAYLIB_H
+
+#include <stdbool.h>
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+typedef struct Vector2 { float x; float y; } Vector2;
+typedef struct Color { unsigned char r; unsigned char g; unsigned char b; unsigned char a; } Color;
+typedef struct Rectangle { float x; float y; float width; float height; } Rectangle;
+
+typedef struct Texture {
+    unsigned int id;
+    int width;
+    int height;
+    int mipmaps;
+    int format;
+} Texture;
+typedef Texture Texture2D;
+
+typedef struct RenderTexture {
+    unsigned int id;
+    Texture texture;
+    Texture depth;
+} RenderTexture;
+typedef RenderTexture RenderTexture2D;
+
+// ============================================================================
+// COLORS, KEYS AND FLAGS
+// ============================================================================
+
+#define LIGHTGRAY  (Color){ 200, 200, 200, 255 }
+#define GRAY       (Color){ 130, 130, 130, 255 }
+#define YELLOW     (Color){ 253, 249, 0, 255 }
+#define RED        (Color){ 230, 41, 55, 255 }
+#define GREEN      (Color){ 0, 228, 48, 255 }
+#define SKYBLUE    (Color){ 102, 191, 255, 255 }
+#define BLUE       (Color){ 0, 121, 241, 255 }
+#define WHITE      (Color){ 255, 255, 255, 255 }
+#define BLACK      (Color){ 0, 0, 0, 255 }
+
+#define KEY_A      65
+#define KEY_D      68
+#define KEY_S      83
+#define KEY_W      87
+#define KEY_ENTER  257
+#define KEY_RIGHT  262
+#define KEY_LEFT   263
+#define KEY_DOWN   264
+#define KEY_UP     265
+
+#define FLAG_VSYNC_HINT 0x00000040
+
+// ============================================================================
+// WINDOW AND INPUT FUNCTIONS
+// ============================================================================
+
+void InitWindow(int width, int height, const char* title);
+void CloseWindow(void);
+bool WindowShouldClose(void);
+void SetConfigFlags(unsigned int flags);
+void SetTargetFPS(int fps);
+int GetCurrentMonitor(void);
+int GetMonitorRefreshRate(int monitor);
+int GetScreenWidth(void);
+int GetScreenHeight(void);
+float GetFrameTime(void);
+double GetTime(void);
+bool IsKeyPressed(int key);
+int GetKeyPressed(void);
+void TakeScreenshot(const char* fileName);
+
+// ============================================================================
+// DRAWING FUNCTIONS
+// ============================================================================
+
+void BeginDrawing(void);
+void EndDrawing(void);
+void ClearBackground(Color color);
+void BeginTextureMode(RenderTexture2D target);
+void EndTextureMode(void);
+RenderTexture2D LoadRenderTexture(int width, int height);
+void UnloadRenderTexture(RenderTexture2D target);
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint);
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color);
+void DrawRectangle(int posX, int posY, int width, int height, Color color);
+void DrawRectangleV(Vector2 position, Vector2 size, Color color);
+void DrawRectangleRec(Rectangle rec, Color color);
+void DrawText(const char* text, int posX, int posY, int fontSize, Color color);
+int MeasureText(const char* text, int fontSize);
+const char* TextFormat(const char* text, ...);
+Color Fade(Color color, float alpha);
+
+// ============================================================================
+// SOFTWARE BACKEND FUNCTIONS
+// ============================================================================
+
+const unsigned char* SoftBackend_GetPixels(void);
+bool SoftBackend_WriteFrame(const char* path);
+
+#endif // RAYLIB_H
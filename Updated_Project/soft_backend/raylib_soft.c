@@ -0,0 +1,1070 @@
+/*
+ * raylib_soft.c
+ *
+ * Software raylib backend for the headless build
+ * Draws the calls the game makes into RGBA buffers in memory: the screen
+ * and any render textures. Opaque fills write one row and copy it down,
+ * so cell-sized and full-screen rectangles cost about a memcpy per row;
+ * translucent fills blend four pixels per SSE2 step where available.
+ * Text uses a built-in 5x8 font scaled to the font size. There is no
+ * window or input: every frame stands for one frame interval of game
+ * time however fast it is drawn, so captured frames play back at the
+ * target frame rate.
+ * TakeScreenshot saves the screen as PNG, or as raw RGBA bytes when the
+ * name ends in .rgba.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "raylib.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__SSE2__)
+#define SOFT_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+#define SOFT_MAX_TARGETS     8      // Screen plus the render textures alive at once
+#define SOFT_DEFAULT_FPS     60
+#define SOFT_FONT_SIZE       10     // Font size drawn at scale 1
+#define SOFT_GLYPH_ADVANCE   6      // Glyph width plus spacing at scale 1
+#define SOFT_TEXT_BUFFERS    4      // TextFormat results usable at once
+#define SOFT_TEXT_LENGTH     1024
+
+#define PNG_MIN_MATCH        3
+#define PNG_MAX_MATCH        258
+#define PNG_MAX_DISTANCE     32768
+
+/*
+ * Pixel buffer drawn into: the screen (slot 0) or a render texture
+ * Render textures are stored bottom-up like on the GPU, so the flipped
+ * source rectangles renderer.c blits them with come out upright.
+ * isOpaque is set while every pixel has full alpha, which lets blits
+ * copy whole rows.
+ */
+typedef struct {
+    uint32_t* pixels;
+    int width;
+    int height;
+    bool isFlipped;
+    bool isOpaque;
+} SoftTarget;
+
+static SoftTarget targets[SOFT_MAX_TARGETS] = { { 0 } };
+static int currentTarget = 0;
+static int targetFps = SOFT_DEFAULT_FPS;
+static struct timespec startTime;
+
+/*
+ * Built-in font for ASCII 32 to 126: five columns per glyph, bit 0 at
+ * the top, bit 7 the descender row
+ */
+static const uint8_t fontGlyphs[95][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, // space !
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, // " #
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, // $ %
+    { 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 }, // & '
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 }, // ( )
+    { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, { 0x08, 0x08, 0x3E, 0x08, 0x08 }, // * +
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, // , -
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 }, // . /
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, // 0 1
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 }, // 2 3
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 }, // 4 5
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 }, // 6 7
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, // 8 9
+    { 0x00, 0x36, 0x36, 0x00, 0x00 }, { 0x00, 0x56, 0x36, 0x00, 0x00 }, // : ;
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, // < =
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 }, // > ?
+    { 0x32, 0x49, 0x79, 0x41, 0x3E }, { 0x7E, 0x11, 0x11, 0x11, 0x7E }, // @ A
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 }, // B C
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, // D E
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x49, 0x49, 0x7A }, // F G
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, // H I
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, // J K
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, // L M
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E }, // N O
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, // P Q
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x46, 0x49, 0x49, 0x49, 0x31 }, // R S
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, // T U
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, // V W
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x07, 0x08, 0x70, 0x08, 0x07 }, // X Y
+    { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 }, // Z [
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 }, // backslash ]
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x80, 0x80, 0x80, 0x80, 0x80 }, // ^ _
+    { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 }, // ` a
+    { 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 }, // b c
+    { 0x38, 0x44, 0x44, 0x48, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 }, // d e
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x18, 0xA4, 0xA4, 0xA4, 0x7C }, // f g
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, // h i
+    { 0x40, 0x80, 0x84, 0x7D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 }, // j k
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 }, // l m
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, // n o
+    { 0xFC, 0x24, 0x24, 0x24, 0x18 }, { 0x18, 0x24, 0x24, 0x24, 0xFC }, // p q
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 }, // r s
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, // t u
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C }, // v w
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x1C, 0xA0, 0xA0, 0xA0, 0x7C }, // x y
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, // z {
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 }, // | }
+    { 0x08, 0x04, 0x08, 0x10, 0x08 }                                    // ~
+};
+
+// ============================================================================
+// PIXEL HELPERS
+// ============================================================================
+
+/*
+ * Pack a color into a pixel; the bytes stay in R, G, B, A order in memory
+ */
+static uint32_t Soft_PackColor(Color color)
+{
+    uint32_t pixel;
+
+    memcpy(&pixel, &color, sizeof(pixel));
+    return pixel;
+}
+
+/*
+ * Blend a pixel over another, two channels per multiply
+ *
+ * @param destination - Pixel underneath
+ * @param source - Pixel on top, with full alpha
+ * @param weight - Source coverage, 0 to 256
+ * @return Blended pixel
+ */
+static uint32_t Soft_Blend(uint32_t destination, uint32_t source, uint32_t weight)
+{
+    uint32_t inverse = 256 - weight;
+    uint32_t evenLanes = ((source & 0x00FF00FFu) * weight + (destination & 0x00FF00FFu) * inverse) >> 8;
+    uint32_t oddLanes = (((source >> 8) & 0x00FF00FFu) * weight +
+                         ((destination >> 8) & 0x00FF00FFu) * inverse) >> 8;
+
+    return (evenLanes & 0x00FF00FFu) | ((oddLanes & 0x00FF00FFu) << 8);
+}
+
+/*
+ * Blend one color over a run of pixels
+ * With SSE2, four pixels per step: every channel widened to 16 bits,
+ * which holds the largest product (255 * 256)
+ *
+ * @param row - First pixel of the run
+ * @param width - Pixels in the run
+ * @param source - Color on top, with full alpha
+ * @param weight - Source coverage, 0 to 256
+ */
+static void Soft_BlendRow(uint32_t* row, size_t width, uint32_t source, uint32_t weight)
+{
+    size_t i = 0;
+
+#ifdef SOFT_HAVE_SSE2
+    __m128i zero = _mm_setzero_si128();
+    __m128i inverse = _mm_set1_epi16((short)(256 - weight));
+    __m128i sourceTerm = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int)source), zero),
+                                         _mm_set1_epi16((short)weight));
+
+    for (; i + 4 <= width; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(row + i));
+        __m128i low = _mm_unpacklo_epi8(pixels, zero);
+        __m128i high = _mm_unpackhi_epi8(pixels, zero);
+
+        low = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(low, inverse), sourceTerm), 8);
+        high = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(high, inverse), sourceTerm), 8);
+        _mm_storeu_si128((__m128i*)(row + i), _mm_packus_epi16(low, high));
+    }
+#endif
+
+    for (; i < width; i++)
+    {
+        row[i] = Soft_Blend(row[i], source, weight);
+    }
+}
+
+/*
+ * Pixel row y of a target, counted from the top of the picture
+ */
+static uint32_t* Soft_GetRow(const SoftTarget* target, int y)
+{
+    int row = target->isFlipped ? target->height - 1 - y : y;
+    return target->pixels + (size_t)row * (size_t)target->width;
+}
+
+/*
+ * Round a coordinate to the nearest pixel edge
+ */
+static int Soft_Round(float value)
+{
+    return (int)floorf(value + 0.5f);
+}
+
+/*
+ * Fill the pixels [x0, x1) x [y0, y1) of the current target, clipped
+ * An opaque fill writes the first row and copies it to the others
+ */
+static void Soft_FillRect(int x0, int y0, int x1, int y1, Color color)
+{
+    SoftTarget* target = &targets[currentTarget];
+
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > target->width) x1 = target->width;
+    if (y1 > target->height) y1 = target->height;
+    if ((x0 >= x1) || (y0 >= y1) || (color.a == 0) || (target->pixels == NULL))
+    {
+        return;
+    }
+
+    uint32_t weight = color.a + (color.a >> 7);
+    size_t width = (size_t)(x1 - x0);
+    color.a = 255;
+    uint32_t pixel = Soft_PackColor(color);
+
+    if (weight == 256)
+    {
+        uint32_t* first = Soft_GetRow(target, y0) + x0;
+        for (size_t i = 0; i < width; i++)
+        {
+            first[i] = pixel;
+        }
+        for (int y = y0 + 1; y < y1; y++)
+        {
+            memcpy(Soft_GetRow(target, y) + x0, first, width * sizeof(uint32_t));
+        }
+        return;
+    }
+
+    for (int y = y0; y < y1; y++)
+    {
+        Soft_BlendRow(Soft_GetRow(target, y) + x0, width, pixel, weight);
+    }
+}
+
+/*
+ * Release a target's pixels and free its slot
+ */
+static void Soft_ReleaseTarget(int slot)
+{
+    free(targets[slot].pixels);
+    memset(&targets[slot], 0, sizeof(SoftTarget));
+}
+
+// ============================================================================
+// WINDOW AND INPUT
+// ============================================================================
+
+void InitWindow(int width, int height, const char* title)
+{
+    (void)title;
+
+    Soft_ReleaseTarget(0);
+    targets[0].pixels = calloc((size_t)width * (size_t)height, sizeof(uint32_t));
+    if (targets[0].pixels != NULL)
+    {
+        targets[0].width = width;
+        targets[0].height = height;
+    }
+
+    currentTarget = 0;
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+}
+
+void CloseWindow(void)
+{
+    for (int slot = 0; slot < SOFT_MAX_TARGETS; slot++)
+    {
+        Soft_ReleaseTarget(slot);
+    }
+}
+
+// Nothing can close a window that does not exist; main.c ends the run
+bool WindowShouldClose(void)
+{
+    return false;
+}
+
+void SetConfigFlags(unsigned int flags)
+{
+    (void)flags;
+}
+
+void SetTargetFPS(int fps)
+{
+    if (fps > 0)
+    {
+        targetFps = fps;
+    }
+}
+
+int GetCurrentMonitor(void)
+{
+    return 0;
+}
+
+// Unknown, so main.c falls back to FALLBACK_FPS
+int GetMonitorRefreshRate(int monitor)
+{
+    (void)monitor;
+    return 0;
+}
+
+int GetScreenWidth(void)
+{
+    return targets[0].width;
+}
+
+int GetScreenHeight(void)
+{
+    return targets[0].height;
+}
+
+// Game time per frame, independent of how long drawing took
+float GetFrameTime(void)
+{
+    return 1.0f / (float)targetFps;
+}
+
+// Wall time since InitWindow, for the draw time and latency readouts
+double GetTime(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - startTime.tv_sec) + (double)(now.tv_nsec - startTime.tv_nsec) / 1e9;
+}
+
+bool IsKeyPressed(int key)
+{
+    (void)key;
+    return false;
+}
+
+int GetKeyPressed(void)
+{
+    return 0;
+}
+
+void TakeScreenshot(const char* fileName)
+{
+    if (!SoftBackend_WriteFrame(fileName))
+    {
+        fprintf(stderr, "Cannot write frame: %s\n", fileName);
+    }
+}
+
+// ============================================================================
+// TARGETS AND TEXTURES
+// ============================================================================
+
+void BeginDrawing(void)
+{
+    currentTarget = 0;
+}
+
+void EndDrawing(void)
+{
+}
+
+RenderTexture2D LoadRenderTexture(int width, int height)
+{
+    RenderTexture2D target;
+
+    memset(&target, 0, sizeof(target));
+    for (int slot = 1; slot < SOFT_MAX_TARGETS; slot++)
+    {
+        if (targets[slot].pixels != NULL)
+        {
+            continue;
+        }
+
+        targets[slot].pixels = calloc((size_t)width * (size_t)height, sizeof(uint32_t));
+        if (targets[slot].pixels == NULL)
+        {
+            break;
+        }
+
+        targets[slot].width = width;
+        targets[slot].height = height;
+        targets[slot].isFlipped = true;
+        target.id = (unsigned int)slot;
+        target.texture.id = target.id;
+        target.texture.width = width;
+        target.texture.height = height;
+        break;
+    }
+
+    return target;
+}
+
+void UnloadRenderTexture(RenderTexture2D target)
+{
+    if ((target.id > 0) && (target.id < SOFT_MAX_TARGETS))
+    {
+        Soft_ReleaseTarget((int)target.id);
+    }
+}
+
+void BeginTextureMode(RenderTexture2D target)
+{
+    if ((target.id > 0) && (target.id < SOFT_MAX_TARGETS) && (targets[target.id].pixels != NULL))
+    {
+        currentTarget = (int)target.id;
+    }
+}
+
+void EndTextureMode(void)
+{
+    currentTarget = 0;
+}
+
+// ============================================================================
+// DRAWING
+// ============================================================================
+
+// Replaces every pixel, alpha included, like a GPU clear
+void ClearBackground(Color color)
+{
+    SoftTarget* target = &targets[currentTarget];
+    uint32_t pixel = Soft_PackColor(color);
+    size_t width = (size_t)target->width;
+
+    if (target->pixels == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < width; i++)
+    {
+        target->pixels[i] = pixel;
+    }
+    for (int row = 1; row < target->height; row++)
+    {
+        memcpy(target->pixels + (size_t)row * width, target->pixels, width * sizeof(uint32_t));
+    }
+
+    target->isOpaque = (color.a == 255);
+}
+
+/*
+ * Copy part of a render texture to the current target
+ * The source rectangle addresses the texture as stored (bottom-up); a
+ * negative height flips it. Opaque sources drawn untinted copy whole rows.
+ */
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint)
+{
+    if ((texture.id == 0) || (texture.id >= SOFT_MAX_TARGETS) ||
+        ((int)texture.id == currentTarget) || (targets[texture.id].pixels == NULL))
+    {
+        return;
+    }
+
+    const SoftTarget* from = &targets[texture.id];
+    SoftTarget* to = &targets[currentTarget];
+    bool isFlippedX = (source.width < 0);
+    bool isFlippedY = (source.height < 0);
+    int sourceX = Soft_Round(source.x);
+    int sourceY = Soft_Round(source.y);
+    int width = Soft_Round(fabsf(source.width));
+    int height = Soft_Round(fabsf(source.height));
+    int x = Soft_Round(position.x);
+    int y = Soft_Round(position.y);
+
+    if ((to->pixels == NULL) || (tint.a == 0) ||
+        (sourceX < 0) || (sourceY < 0) || (sourceX + width > from->width) || (sourceY + height > from->height))
+    {
+        return;
+    }
+
+    // Clip against the destination
+    int skipLeft = (x < 0) ? -x : 0;
+    int skipTop = (y < 0) ? -y : 0;
+    int right = (x + width < to->width) ? x + width : to->width;
+    int bottom = (y + height < to->height) ? y + height : to->height;
+    if ((x + skipLeft >= right) || (y + skipTop >= bottom))
+    {
+        return;
+    }
+
+    bool isPlainCopy = from->isOpaque && !isFlippedX &&
+                       (tint.r == 255) && (tint.g == 255) && (tint.b == 255) && (tint.a == 255);
+    int count = right - x - skipLeft;
+
+    for (int row = skipTop; row < bottom - y; row++)
+    {
+        int sourceRow = isFlippedY ? sourceY + height - 1 - row : sourceY + row;
+        const uint32_t* sourcePixels = from->pixels + (size_t)sourceRow * (size_t)from->width + sourceX;
+        uint32_t* destination = Soft_GetRow(to, y + row) + x + skipLeft;
+
+        if (isPlainCopy)
+        {
+            memcpy(destination, sourcePixels + skipLeft, (size_t)count * sizeof(uint32_t));
+            continue;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            int column = isFlippedX ? width - 1 - (skipLeft + i) : skipLeft + i;
+            Color color;
+            memcpy(&color, &sourcePixels[column], sizeof(color));
+            color.r = (unsigned char)(color.r * tint.r / 255);
+            color.g = (unsigned char)(color.g * tint.g / 255);
+            color.b = (unsigned char)(color.b * tint.b / 255);
+            color.a = (unsigned char)(color.a * tint.a / 255);
+
+            uint32_t weight = color.a + (color.a >> 7);
+            color.a = 255;
+            destination[i] = Soft_Blend(destination[i], Soft_PackColor(color), weight);
+        }
+    }
+
+    // An opaque copy over the whole target leaves it opaque
+    if (isPlainCopy && (x <= 0) && (y <= 0) && (x + width >= to->width) && (y + height >= to->height))
+    {
+        to->isOpaque = true;
+    }
+}
+
+/*
+ * One pixel wide line; horizontal and vertical lines are filled as
+ * rectangles, others stepped with Bresenham
+ */
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color)
+{
+    int x0 = (int)floorf(startPos.x);
+    int y0 = (int)floorf(startPos.y);
+    int x1 = (int)floorf(endPos.x);
+    int y1 = (int)floorf(endPos.y);
+
+    if (x0 == x1)
+    {
+        Soft_FillRect(x0, (y0 < y1) ? y0 : y1, x0 + 1, ((y0 < y1) ? y1 : y0) + 1, color);
+        return;
+    }
+    if (y0 == y1)
+    {
+        Soft_FillRect((x0 < x1) ? x0 : x1, y0, ((x0 < x1) ? x1 : x0) + 1, y0 + 1, color);
+        return;
+    }
+
+    int dx = abs(x1 - x0);
+    int dy = -abs(y1 - y0);
+    int stepX = (x0 < x1) ? 1 : -1;
+    int stepY = (y0 < y1) ? 1 : -1;
+    int error = dx + dy;
+
+    while (true)
+    {
+        Soft_FillRect(x0, y0, x0 + 1, y0 + 1, color);
+        if ((x0 == x1) && (y0 == y1))
+        {
+            break;
+        }
+
+        int doubled = 2 * error;
+        if (doubled >= dy)
+        {
+            error += dy;
+            x0 += stepX;
+        }
+        if (doubled <= dx)
+        {
+            error += dx;
+            y0 += stepY;
+        }
+    }
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    Soft_FillRect(posX, posY, posX + width, posY + height, color);
+}
+
+void DrawRectangleV(Vector2 position, Vector2 size, Color color)
+{
+    Soft_FillRect(Soft_Round(position.x), Soft_Round(position.y),
+                  Soft_Round(position.x + size.x), Soft_Round(position.y + size.y), color);
+}
+
+void DrawRectangleRec(Rectangle rec, Color color)
+{
+    Soft_FillRect(Soft_Round(rec.x), Soft_Round(rec.y),
+                  Soft_Round(rec.x + rec.width), Soft_Round(rec.y + rec.height), color);
+}
+
+/*
+ * Draw text with the built-in font, scaled by whole pixels
+ * Each glyph column is filled as runs of set bits, one rectangle per run
+ */
+void DrawText(const char* text, int posX, int posY, int fontSize, Color color)
+{
+    int scale = (fontSize > SOFT_FONT_SIZE) ? fontSize / SOFT_FONT_SIZE : 1;
+    int x = posX;
+    int y = posY + scale;
+
+    for (const char* c = text; *c != '\0'; c++)
+    {
+        if (*c == '\n')
+        {
+            x = posX;
+            y += (SOFT_FONT_SIZE + 2) * scale;
+            continue;
+        }
+
+        int index = ((*c >= 32) && (*c <= 126)) ? *c - 32 : '?' - 32;
+        for (int column = 0; column < 5; column++)
+        {
+            unsigned int bits = fontGlyphs[index][column];
+            int row = 0;
+            while (bits != 0)
+            {
+                // Skip to the next run of set bits and measure it
+                while (!(bits & 1u))
+                {
+                    bits >>= 1;
+                    row++;
+                }
+                int runStart = row;
+                while (bits & 1u)
+                {
+                    bits >>= 1;
+                    row++;
+                }
+
+                int left = x + column * scale;
+                Soft_FillRect(left, y + runStart * scale, left + scale, y + row * scale, color);
+            }
+        }
+
+        x += SOFT_GLYPH_ADVANCE * scale;
+    }
+}
+
+// ============================================================================
+// TEXT AND COLOR HELPERS
+// ============================================================================
+
+// Width of the longest line as DrawText draws it
+int MeasureText(const char* text, int fontSize)
+{
+    int scale = (fontSize > SOFT_FONT_SIZE) ? fontSize / SOFT_FONT_SIZE : 1;
+    int longest = 0;
+    int length = 0;
+
+    for (const char* c = text; ; c++)
+    {
+        if ((*c == '\n') || (*c == '\0'))
+        {
+            longest = (length > longest) ? length : longest;
+            length = 0;
+            if (*c == '\0')
+            {
+                break;
+            }
+            continue;
+        }
+        length++;
+    }
+
+    return (longest > 0) ? (longest * SOFT_GLYPH_ADVANCE - 1) * scale : 0;
+}
+
+// Results rotate through a few buffers, so several can be used at once
+const char* TextFormat(const char* text, ...)
+{
+    static char buffers[SOFT_TEXT_BUFFERS][SOFT_TEXT_LENGTH];
+    static int next = 0;
+    char* buffer = buffers[next];
+    va_list args;
+
+    next = (next + 1) % SOFT_TEXT_BUFFERS;
+    va_start(args, text);
+    vsnprintf(buffer, SOFT_TEXT_LENGTH, text, args);
+    va_end(args);
+
+    return buffer;
+}
+
+Color Fade(Color color, float alpha)
+{
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+
+    color.a = (unsigned char)(alpha * 255.0f);
+    return color;
+}
+
+// ============================================================================
+// PNG ENCODER
+// ============================================================================
+
+/*
+ * Bits written least significant first into a byte buffer, as deflate
+ * packs them
+ */
+typedef struct {
+    uint8_t* bytes;
+    size_t size;
+    uint64_t bits;
+    int bitCount;
+} PngBitWriter;
+
+/*
+ * Append count bits of value to the stream
+ */
+static void Png_WriteBits(PngBitWriter* writer, uint32_t value, int count)
+{
+    writer->bits |= (uint64_t)value << writer->bitCount;
+    writer->bitCount += count;
+    while (writer->bitCount >= 8)
+    {
+        writer->bytes[writer->size++] = (uint8_t)writer->bits;
+        writer->bits >>= 8;
+        writer->bitCount -= 8;
+    }
+}
+
+/*
+ * Append a Huffman code, which deflate stores most significant bit first
+ */
+static void Png_WriteCode(PngBitWriter* writer, uint32_t code, int length)
+{
+    uint32_t reversed = 0;
+
+    for (int i = 0; i < length; i++)
+    {
+        reversed = (reversed << 1) | ((code >> i) & 1u);
+    }
+    Png_WriteBits(writer, reversed, length);
+}
+
+/*
+ * Append a literal/length symbol with the fixed Huffman code
+ */
+static void Png_WriteSymbol(PngBitWriter* writer, int symbol)
+{
+    if (symbol < 144)
+    {
+        Png_WriteCode(writer, 0x30u + (uint32_t)symbol, 8);
+    }
+    else if (symbol < 256)
+    {
+        Png_WriteCode(writer, 0x190u + (uint32_t)(symbol - 144), 9);
+    }
+    else if (symbol < 280)
+    {
+        Png_WriteCode(writer, (uint32_t)(symbol - 256), 7);
+    }
+    else
+    {
+        Png_WriteCode(writer, 0xC0u + (uint32_t)(symbol - 280), 8);
+    }
+}
+
+/*
+ * Append a back reference: length 3 to 258, distance 1 to 32768
+ */
+static void Png_WriteMatch(PngBitWriter* writer, int length, int distance)
+{
+    static const uint16_t lengthBase[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    static const uint8_t lengthExtra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    static const uint16_t distanceBase[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+    };
+    static const uint8_t distanceExtra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+
+    int code = 28;
+    while (lengthBase[code] > length)
+    {
+        code--;
+    }
+    Png_WriteSymbol(writer, 257 + code);
+    Png_WriteBits(writer, (uint32_t)(length - lengthBase[code]), lengthExtra[code]);
+
+    code = 29;
+    while (distanceBase[code] > distance)
+    {
+        code--;
+    }
+    Png_WriteCode(writer, (uint32_t)code, 5);
+    Png_WriteBits(writer, (uint32_t)(distance - distanceBase[code]), distanceExtra[code]);
+}
+
+/*
+ * Length of the match at position against the data distance bytes back
+ */
+static int Png_GetMatchLength(const uint8_t* data, size_t size, size_t position, size_t distance)
+{
+    size_t limit = size - position;
+    size_t length = 0;
+
+    if (limit > PNG_MAX_MATCH)
+    {
+        limit = PNG_MAX_MATCH;
+    }
+    // Eight bytes at a time, then the bytes of the first difference
+    while (length + 8 <= limit)
+    {
+        uint64_t current;
+        uint64_t earlier;
+        memcpy(&current, data + position + length, sizeof(current));
+        memcpy(&earlier, data + position + length - distance, sizeof(earlier));
+        if (current != earlier)
+        {
+            break;
+        }
+        length += 8;
+    }
+    while ((length < limit) && (data[position + length] == data[position + length - distance]))
+    {
+        length++;
+    }
+
+    return (int)length;
+}
+
+/*
+ * Compress data into a zlib stream with one fixed-Huffman deflate block
+ * Frames are mostly flat color and repeated rows, so the only matches
+ * tried are the previous pixel and the row above
+ *
+ * @param writer - Receives the stream; needs room for size * 9 / 8 + 16 bytes
+ * @param data - Filtered scanlines
+ * @param size - Bytes of data
+ * @param stride - Bytes per scanline, filter byte included
+ */
+static void Png_Deflate(PngBitWriter* writer, const uint8_t* data, size_t size, size_t stride)
+{
+    uint32_t adlerLow = 1;
+    uint32_t adlerHigh = 0;
+
+    writer->bytes[writer->size++] = 0x78;   // Deflate, 32K window
+    writer->bytes[writer->size++] = 0x01;
+    Png_WriteBits(writer, 1, 1);            // Final block
+    Png_WriteBits(writer, 1, 2);            // Fixed Huffman codes
+
+    size_t position = 0;
+    while (position < size)
+    {
+        int length = 0;
+        size_t distance = 0;
+
+        if (position >= 4)
+        {
+            length = Png_GetMatchLength(data, size, position, 4);
+            distance = 4;
+        }
+        if ((position >= stride) && (stride <= PNG_MAX_DISTANCE) && (length < PNG_MAX_MATCH))
+        {
+            int rowLength = Png_GetMatchLength(data, size, position, stride);
+            if (rowLength > length)
+            {
+                length = rowLength;
+                distance = stride;
+            }
+        }
+
+        if (length >= PNG_MIN_MATCH)
+        {
+            Png_WriteMatch(writer, length, (int)distance);
+            position += (size_t)length;
+        }
+        else
+        {
+            Png_WriteSymbol(writer, data[position]);
+            position++;
+        }
+    }
+
+    Png_WriteSymbol(writer, 256);           // End of block
+    Png_WriteBits(writer, 0, 7);            // Pad to a byte boundary
+
+    // Adler-32 in blocks short enough not to overflow
+    for (size_t start = 0; start < size; start += 5552)
+    {
+        size_t end = (start + 5552 < size) ? start + 5552 : size;
+        for (size_t i = start; i < end; i++)
+        {
+            adlerLow += data[i];
+            adlerHigh += adlerLow;
+        }
+        adlerLow %= 65521;
+        adlerHigh %= 65521;
+    }
+
+    uint32_t adler = (adlerHigh << 16) | adlerLow;
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        writer->bytes[writer->size++] = (uint8_t)(adler >> shift);
+    }
+}
+
+/*
+ * CRC-32 of a PNG chunk's type and data
+ */
+static uint32_t Png_Crc(const uint8_t* data, size_t size)
+{
+    static uint32_t table[256];
+    static bool isTableReady = false;
+
+    if (!isTableReady)
+    {
+        for (uint32_t n = 0; n < 256; n++)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++)
+            {
+                c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        isTableReady = true;
+    }
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/*
+ * Write a big-endian 32-bit value
+ */
+static void Png_PutU32(uint8_t* out, uint32_t value)
+{
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+/*
+ * Write one chunk: length, type, data and CRC
+ *
+ * @param chunk - Chunk with 8 bytes of room before the data and 4 after
+ * @param type - Four-letter chunk type
+ * @param size - Bytes of data
+ * @return true if the whole chunk was written
+ */
+static bool Png_WriteChunk(FILE* file, uint8_t* chunk, const char* type, size_t size)
+{
+    Png_PutU32(chunk, (uint32_t)size);
+    memcpy(chunk + 4, type, 4);
+    Png_PutU32(chunk + 8 + size, Png_Crc(chunk + 4, size + 4));
+
+    return fwrite(chunk, 1, size + 12, file) == size + 12;
+}
+
+/*
+ * Save the screen as an 8-bit RGBA PNG
+ */
+static bool Png_WriteScreen(FILE* file, const SoftTarget* screen)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    size_t stride = 1 + (size_t)screen->width * 4;
+    size_t size = stride * (size_t)screen->height;
+    uint8_t* scanlines = malloc(size);
+    uint8_t* chunk = malloc(size + size / 8 + 64);
+
+    if ((scanlines == NULL) || (chunk == NULL))
+    {
+        free(scanlines);
+        free(chunk);
+        return false;
+    }
+
+    // Filter type 0 (none) on every scanline
+    for (int y = 0; y < screen->height; y++)
+    {
+        scanlines[(size_t)y * stride] = 0;
+        memcpy(scanlines + (size_t)y * stride + 1, Soft_GetRow(screen, y), stride - 1);
+    }
+
+    uint8_t* header = chunk + 8;
+    Png_PutU32(header, (uint32_t)screen->width);
+    Png_PutU32(header + 4, (uint32_t)screen->height);
+    header[8] = 8;      // Bits per channel
+    header[9] = 6;      // RGBA
+    header[10] = 0;     // Deflate
+    header[11] = 0;     // Adaptive filtering
+    header[12] = 0;     // Not interlaced
+
+    bool isWritten = (fwrite(signature, 1, sizeof(signature), file) == sizeof(signature)) &&
+                     Png_WriteChunk(file, chunk, "IHDR", 13);
+
+    PngBitWriter writer = { chunk + 8, 0, 0, 0 };
+    Png_Deflate(&writer, scanlines, size, stride);
+    isWritten = isWritten && Png_WriteChunk(file, chunk, "IDAT", writer.size) &&
+                Png_WriteChunk(file, chunk, "IEND", 0);
+
+    free(scanlines);
+    free(chunk);
+    return isWritten;
+}
+
+// ============================================================================
+// SOFTWARE BACKEND FUNCTIONS
+// ============================================================================
+
+/*
+ * Pixels of the last drawn screen
+ *
+ * @return GetScreenWidth() * GetScreenHeight() RGBA pixels, top row
+ *         first, or NULL before InitWindow
+ */
+const unsigned char* SoftBackend_GetPixels(void)
+{
+    return (const unsigned char*)targets[0].pixels;
+}
+
+/*
+ * Save the screen to a file: raw RGBA bytes if the name ends in .rgba,
+ * otherwise PNG
+ *
+ * @param path - File to write
+ * @return true on success, false if the file could not be written
+ */
+bool SoftBackend_WriteFrame(const char* path)
+{
+    const SoftTarget* screen = &targets[0];
+    size_t length = strlen(path);
+    bool isRaw = (length >= 5) && (strcmp(path + length - 5, ".rgba") == 0);
+
+    if (screen->pixels == NULL)
+    {
+        return false;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    size_t count = (size_t)screen->width * (size_t)screen->height;
+    bool isWritten = isRaw ? (fwrite(screen->pixels, sizeof(uint32_t), count, file) == count)
+                           : Png_WriteScreen(file, screen);
+
+    return (fclose(file) == 0) && isWritten;
+}
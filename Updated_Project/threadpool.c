@@ -0,0 +1,332 @@
+/*
+ * threadpool.c
+ *
+ * Work-stealing thread pool
+ * Splits a parallel loop into chunks, hands each worker a contiguous run
+ * of chunks and lets idle workers steal from the back of busy workers'
+ * runs. The calling thread takes part as worker 0.
+ *
+ * Course: Advanced Programming Lab
+ * Date: February 2026
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "snake_sim.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#define CACHE_LINE_SIZE 64
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/*
+ * Chunk range owned by one worker
+ * The owner takes chunks from the front, thieves from the back.
+ * Padded to a cache line so workers do not share lines.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    int next;
+    int end;
+    char padding[CACHE_LINE_SIZE - (sizeof(pthread_mutex_t) + 2 * sizeof(int)) % CACHE_LINE_SIZE];
+} WorkQueue;
+
+/*
+ * Arguments for one worker thread
+ */
+typedef struct {
+    ThreadPool* pool;
+    int index;
+} WorkerInfo;
+
+struct ThreadPool {
+    int threadCount;
+    pthread_t* threads;
+    WorkerInfo* workers;
+    WorkQueue* queues;
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    unsigned generation;
+    int busyWorkers;
+    bool shutdown;
+
+    ThreadPoolTask task;
+    void* context;
+    int itemCount;
+    int chunkSize;
+};
+
+// ============================================================================
+// CHUNK SCHEDULING
+// ============================================================================
+
+/*
+ * Take the next chunk from a worker's own queue, or steal one
+ *
+ * @param pool - Pointer to pool
+ * @param self - Index of the calling worker
+ * @return Chunk index, or -1 when every queue is empty
+ */
+static int ThreadPool_TakeChunk(ThreadPool* pool, int self)
+{
+    WorkQueue* own = &pool->queues[self];
+    int chunk = -1;
+
+    pthread_mutex_lock(&own->lock);
+    if (own->next < own->end)
+    {
+        chunk = own->next++;
+    }
+    pthread_mutex_unlock(&own->lock);
+
+    for (int i = 1; chunk < 0 && i < pool->threadCount; i++)
+    {
+        WorkQueue* victim = &pool->queues[(self + i) % pool->threadCount];
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->next < victim->end)
+        {
+            chunk = --victim->end;
+        }
+        pthread_mutex_unlock(&victim->lock);
+    }
+
+    return chunk;
+}
+
+/*
+ * Run chunks until no work is left anywhere
+ *
+ * @param pool - Pointer to pool
+ * @param self - Index of the calling worker
+ */
+static void ThreadPool_RunChunks(ThreadPool* pool, int self)
+{
+    int chunk;
+
+    while ((chunk = ThreadPool_TakeChunk(pool, self)) >= 0)
+    {
+        int begin = chunk * pool->chunkSize;
+        int end = begin + pool->chunkSize;
+        if (end > pool->itemCount)
+        {
+            end = pool->itemCount;
+        }
+
+        pool->task(pool->context, begin, end);
+    }
+}
+
+/*
+ * Worker thread entry point
+ * Sleeps until a new job generation is published, runs chunks, reports
+ */
+static void* ThreadPool_WorkerMain(void* argument)
+{
+    WorkerInfo* info = argument;
+    ThreadPool* pool = info->pool;
+    unsigned seenGeneration = 0;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && pool->generation == seenGeneration)
+        {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->shutdown)
+        {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        seenGeneration = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        ThreadPool_RunChunks(pool, info->index);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busyWorkers == 0)
+        {
+            pthread_cond_signal(&pool->done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+// ============================================================================
+// CREATION AND DESTRUCTION
+// ============================================================================
+
+/*
+ * Create a pool with the given number of workers (including the caller)
+ *
+ * @param threadCount - Total worker count, at least 1
+ * @return New pool, or NULL if threads or memory could not be obtained
+ */
+ThreadPool* ThreadPool_Create(int threadCount)
+{
+    assert(threadCount >= 1);
+
+    ThreadPool* pool = calloc(1, sizeof(ThreadPool));
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+
+    pool->threadCount = threadCount;
+    pool->threads = calloc((size_t)threadCount, sizeof(pthread_t));
+    pool->workers = calloc((size_t)threadCount, sizeof(WorkerInfo));
+    if (posix_memalign((void**)&pool->queues, CACHE_LINE_SIZE,
+                       (size_t)threadCount * sizeof(WorkQueue)) != 0)
+    {
+        pool->queues = NULL;
+    }
+
+    if (pool->threads == NULL || pool->workers == NULL || pool->queues == NULL)
+    {
+        free(pool->threads);
+        free(pool->workers);
+        free(pool->queues);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        pthread_mutex_init(&pool->queues[i].lock, NULL);
+        pool->queues[i].next = 0;
+        pool->queues[i].end = 0;
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+    }
+
+    // Worker 0 is the calling thread
+    for (int i = 1; i < threadCount; i++)
+    {
+        if (pthread_create(&pool->threads[i], NULL, ThreadPool_WorkerMain, &pool->workers[i]) != 0)
+        {
+            pool->threadCount = i;
+            ThreadPool_Destroy(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+/*
+ * Stop all workers and release the pool
+ *
+ * @param pool - Pool to destroy (may be NULL)
+ */
+void ThreadPool_Destroy(ThreadPool* pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->threadCount; i++)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    for (int i = 0; i < pool->threadCount; i++)
+    {
+        pthread_mutex_destroy(&pool->queues[i].lock);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->done);
+
+    free(pool->threads);
+    free(pool->workers);
+    free(pool->queues);
+    free(pool);
+}
+
+/*
+ * Get the number of workers in a pool (including the caller)
+ *
+ * @param pool - Pointer to pool
+ * @return Worker count
+ */
+int ThreadPool_GetThreadCount(const ThreadPool* pool)
+{
+    assert(pool != NULL);
+
+    return pool->threadCount;
+}
+
+// ============================================================================
+// PARALLEL LOOP
+// ============================================================================
+
+/*
+ * Run task over [0, itemCount) in chunks and wait for completion
+ * Each worker starts with an equal contiguous run of chunks
+ *
+ * @param pool - Pointer to pool
+ * @param itemCount - Number of items to process
+ * @param chunkSize - Items per chunk
+ * @param task - Function called with [begin, end) item ranges
+ * @param context - Passed through to task
+ */
+void ThreadPool_ParallelFor(ThreadPool* pool, int itemCount, int chunkSize,
+                            ThreadPoolTask task, void* context)
+{
+    assert(pool != NULL);
+    assert(chunkSize > 0);
+    assert(task != NULL);
+
+    if (itemCount <= 0)
+    {
+        return;
+    }
+
+    int chunkCount = (itemCount + chunkSize - 1) / chunkSize;
+
+    pool->task = task;
+    pool->context = context;
+    pool->itemCount = itemCount;
+    pool->chunkSize = chunkSize;
+
+    for (int i = 0; i < pool->threadCount; i++)
+    {
+        pthread_mutex_lock(&pool->queues[i].lock);
+        pool->queues[i].next = (int)((long long)chunkCount * i / pool->threadCount);
+        pool->queues[i].end = (int)((long long)chunkCount * (i + 1) / pool->threadCount);
+        pthread_mutex_unlock(&pool->queues[i].lock);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->busyWorkers = pool->threadCount - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    ThreadPool_RunChunks(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busyWorkers > 0)
+    {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
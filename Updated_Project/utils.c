@@ -8,46 +8,113 @@
  * Date: February 2026
  */
 
-#include "snake_game.h"
+#include "snake_sim.h"
+
+// ============================================================================
+// BOARD CONFIGURATION
+// ============================================================================
+
+/*
+ * Board dimensions in use and the cell size that fits them on screen
+ */
+typedef struct {
+    int columns;
+    int rows;
+    int cellSize;
+} BoardConfig;
+
+static BoardConfig boardConfig = { DEFAULT_GRID_COLUMNS, DEFAULT_GRID_ROWS, SQUARE_SIZE };
+
+/*
+ * Set the board dimensions used by games created from now on
+ * Cells shrink from SQUARE_SIZE down to one pixel so the board fits the
+ * screen where possible; larger boards are drawn centered and cropped.
+ * Existing SimStates keep the size they were created with and must be
+ * recreated with Sim_Create to follow a change.
+ * 
+ * @param columns - Board width in cells
+ * @param rows - Board height in cells
+ * @return true if the size is within BOARD_MIN_SIZE..BOARD_MAX_SIZE
+ */
+bool Utils_SetBoardSize(int columns, int rows)
+{
+    if ((columns < BOARD_MIN_SIZE) || (columns > BOARD_MAX_SIZE) ||
+        (rows < BOARD_MIN_SIZE) || (rows > BOARD_MAX_SIZE))
+    {
+        return false;
+    }
+
+    int cellSize = SCREEN_WIDTH / columns;
+    if (SCREEN_HEIGHT / rows < cellSize) cellSize = SCREEN_HEIGHT / rows;
+    if (cellSize > SQUARE_SIZE) cellSize = SQUARE_SIZE;
+    if (cellSize < 1) cellSize = 1;
+
+    boardConfig.columns = columns;
+    boardConfig.rows = rows;
+    boardConfig.cellSize = cellSize;
+
+    return true;
+}
 
 // ============================================================================
 // GRID CALCULATIONS
 // ============================================================================
 
 /*
- * Calculate number of columns in the game grid
+ * Get the number of columns in the game grid
  * 
- * @return Number of columns that fit in screen width
+ * @return Board width in cells
  */
 int Utils_GetGridColumns(void)
 {
-    return SCREEN_WIDTH / SQUARE_SIZE;
+    return boardConfig.columns;
 }
 
 /*
- * Calculate number of rows in the game grid
+ * Get the number of rows in the game grid
  * 
- * @return Number of rows that fit in screen height
+ * @return Board height in cells
  */
 int Utils_GetGridRows(void)
 {
-    return SCREEN_HEIGHT / SQUARE_SIZE;
+    return boardConfig.rows;
+}
+
+/*
+ * Get the number of cells on the board
+ * 
+ * @return Columns times rows
+ */
+int Utils_GetCellCount(void)
+{
+    return boardConfig.columns * boardConfig.rows;
+}
+
+/*
+ * Get the on-screen size of one cell
+ * 
+ * @return Cell side in pixels
+ */
+int Utils_GetCellSize(void)
+{
+    return boardConfig.cellSize;
 }
 
 /*
  * Calculate grid offset to center the grid on screen
  * Handles cases where grid doesn't perfectly fit screen dimensions
  * 
- * @return Vector2 containing x and y offsets
+ * @return Position containing x and y offsets
  */
-Vector2 Utils_CalculateGridOffset(void)
+Position Utils_CalculateGridOffset(void)
 {
     int cols = Utils_GetGridColumns();
     int rows = Utils_GetGridRows();
+    int cellSize = Utils_GetCellSize();
     
-    Vector2 offset;
-    offset.x = (float)((SCREEN_WIDTH - cols * SQUARE_SIZE) / 2);
-    offset.y = (float)((SCREEN_HEIGHT - rows * SQUARE_SIZE) / 2);
+    Position offset;
+    offset.x = (float)((SCREEN_WIDTH - cols * cellSize) / 2);
+    offset.y = (float)((SCREEN_HEIGHT - rows * cellSize) / 2);
     
     return offset;
 }
@@ -63,16 +130,75 @@ Vector2 Utils_CalculateGridOffset(void)
  * @param gridOffset - Grid offset for boundary calculation
  * @return true if position is valid, false otherwise
  */
-bool Utils_IsPositionValid(Vector2 position, Vector2 gridOffset)
+bool Utils_IsPositionValid(Position position, Position gridOffset)
 {
     int cols = Utils_GetGridColumns();
     int rows = Utils_GetGridRows();
+    int cellSize = Utils_GetCellSize();
     
     float minX = gridOffset.x;
     float minY = gridOffset.y;
-    float maxX = gridOffset.x + (cols - 1) * SQUARE_SIZE;
-    float maxY = gridOffset.y + (rows - 1) * SQUARE_SIZE;
+    float maxX = gridOffset.x + (cols - 1) * cellSize;
+    float maxY = gridOffset.y + (rows - 1) * cellSize;
     
     return (position.x >= minX && position.x <= maxX &&
             position.y >= minY && position.y <= maxY);
 }
+
+/*
+ * Convert a position on the grid into a linear cell index
+ * Cells are numbered row by row starting at the top-left corner
+ * 
+ * @param position - Position of a grid cell (must be valid)
+ * @param gridOffset - Grid offset for coordinate conversion
+ * @return Cell index in the range [0, columns * rows)
+ */
+int Utils_GetCellIndex(Position position, Position gridOffset)
+{
+    int column = (int)((position.x - gridOffset.x) / Utils_GetCellSize());
+    int row = (int)((position.y - gridOffset.y) / Utils_GetCellSize());
+
+    return row * Utils_GetGridColumns() + column;
+}
+
+/*
+ * Convert a linear cell index back into the position of its top-left corner
+ * 
+ * @param cell - Cell index in the range [0, columns * rows)
+ * @param gridOffset - Grid offset for coordinate conversion
+ * @return Position of the cell on screen
+ */
+Position Utils_GetCellPosition(int cell, Position gridOffset)
+{
+    int columns = Utils_GetGridColumns();
+    int cellSize = Utils_GetCellSize();
+
+    Position position;
+    position.x = gridOffset.x + (float)((cell % columns) * cellSize);
+    position.y = gridOffset.y + (float)((cell / columns) * cellSize);
+
+    return position;
+}
+
+/*
+ * Get the four cells next to a cell, wrapping around the board
+ * Takes the board size from the caller, so searches sized to a board
+ * keep working while the configured size changes
+ *
+ * @param columns - Columns of the board
+ * @param cellCount - Cells on the board
+ * @param cell - Cell index
+ * @param neighbors - Receives the cells above, below, left and right
+ *                    (indexed by SimAction - 1)
+ */
+void Utils_GetNeighborCells(int columns, int cellCount, uint32_t cell, uint32_t neighbors[4])
+{
+    uint32_t width = (uint32_t)columns;
+    uint32_t column = cell % width;
+    uint32_t rowStart = cell - column;
+
+    neighbors[0] = (cell >= width) ? cell - width : cell + (uint32_t)cellCount - width;
+    neighbors[1] = (cell + width < (uint32_t)cellCount) ? cell + width : column;
+    neighbors[2] = (column > 0) ? cell - 1 : rowStart + width - 1;
+    neighbors[3] = (column + 1 < width) ? cell + 1 : rowStart;
+}